@@ -0,0 +1,61 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+
+#include <TINYSTL/vector.h>
+#include <stdlib.h>
+
+// Same heap as tinystl::allocator, but without the reallocate hook, so
+// every growth step allocates a new block and copies into it.
+struct copying_allocator {
+	static void* static_allocate(size_t bytes) {
+		return tinystl::allocator::static_allocate(bytes);
+	}
+
+	static void static_deallocate(void* ptr, size_t bytes) {
+		tinystl::allocator::static_deallocate(ptr, bytes);
+	}
+};
+
+template<typename Alloc>
+static void grow(const char* name, size_t count) {
+	const double start = bench::now();
+	{
+		tinystl::vector<size_t, Alloc> v;
+		for (size_t ii = 0; ii < count; ++ii)
+			v.push_back(ii);
+		bench::do_not_optimize(v);
+	}
+	bench::report(name, count, bench::now() - start);
+}
+
+BENCHMARK(reallocate_vector_growth) {
+	grow<copying_allocator>("allocate+copy, 1M elements", 1024 * 1024);
+	grow<tinystl::allocator>("reallocate, 1M elements", 1024 * 1024);
+	grow<copying_allocator>("allocate+copy, 32M elements", 32 * 1024 * 1024);
+	grow<tinystl::allocator>("reallocate, 32M elements", 32 * 1024 * 1024);
+}
@@ -0,0 +1,75 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+
+#include <TINYSTL/compact_vector.h>
+#include <TINYSTL/tracking_allocator.h>
+#include <TINYSTL/vector.h>
+
+static const size_t c_lists = 1000000;
+
+struct compact_bench_vector_tag {};
+struct compact_bench_compact_tag {};
+
+// Builds an adjacency list of c_lists short edge lists and reports the
+// memory held by the list headers plus their heap blocks.
+template<typename List, typename Tag>
+static void compact_adjacency(const char* name) {
+	const size_t before = tinystl::tracking_tag_counts<Tag>().live_bytes;
+
+	double start = bench::now();
+	{
+		tinystl::vector<List> lists;
+		lists.resize(c_lists);
+		for (size_t ii = 0; ii < c_lists; ++ii) {
+			const size_t degree = 1 + (ii * 7) % 6;
+			for (size_t jj = 0; jj < degree; ++jj)
+				lists[ii].push_back((unsigned int)((ii + jj * 31) % c_lists));
+		}
+		bench::report(name, c_lists, bench::now() - start);
+
+		const size_t heap = tinystl::tracking_tag_counts<Tag>().live_bytes - before;
+		const size_t headers = sizeof(List) * c_lists;
+		bench::report_value("  header bytes per list", "bytes", (double)sizeof(List));
+		bench::report_value("  total bytes per list", "bytes", (double)(headers + heap) / c_lists);
+
+		start = bench::now();
+		size_t sum = 0;
+		for (size_t ii = 0; ii < c_lists; ++ii) {
+			const List& list = lists[ii];
+			for (const unsigned int* it = list.begin(), *end = list.end(); it != end; ++it)
+				sum += *it;
+		}
+		bench::do_not_optimize(sum);
+		bench::report("  traverse", c_lists, bench::now() - start);
+	}
+}
+
+BENCHMARK(compact_vector_adjacency) {
+	compact_adjacency<tinystl::vector<unsigned int, tinystl::tracking_allocator<compact_bench_vector_tag> >, compact_bench_vector_tag>("tinystl::vector");
+	compact_adjacency<tinystl::compact_vector<unsigned int, tinystl::tracking_allocator<compact_bench_compact_tag> >, compact_bench_compact_tag>("tinystl::compact_vector");
+}
@@ -0,0 +1,92 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+
+#include <TINYSTL/cuckoo_set.h>
+#include <TINYSTL/flat_hash_set.h>
+#include <TINYSTL/unordered_set.h>
+
+#include <algorithm>
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+
+static const size_t c_keys = 1 << 20;
+static const size_t c_lookups = 1 << 21;
+
+static uint64_t cuckoo_key(size_t index) {
+	return (uint64_t)index * 0x9E3779B97F4A7C15ull;
+}
+
+// Times every lookup on its own, so the figures include the cost of
+// reading the clock; half the lookups miss
+template<typename Set>
+static void cuckoo_lookup_latency(const char* name) {
+	Set s;
+	for (size_t ii = 0; ii < c_keys; ++ii)
+		s.insert(cuckoo_key(ii));
+
+	std::vector<double> latencies;
+	latencies.reserve(c_lookups);
+
+	size_t found = 0;
+	uint32_t state = 1;
+	const double start = bench::now();
+	for (size_t ii = 0; ii < c_lookups; ++ii) {
+		state = state * 1664525u + 1013904223u;
+		const uint64_t key = cuckoo_key(state % (2 * c_keys));
+
+		const double before = bench::now();
+		found += (s.find(key) != s.end());
+		latencies.push_back(bench::now() - before);
+	}
+	const double seconds = bench::now() - start;
+	bench::do_not_optimize(found);
+
+	std::sort(latencies.begin(), latencies.end());
+	bench::report(name, c_lookups, seconds);
+	bench::report_value("  p50 lookup", "ns", latencies[latencies.size() / 2] * 1e9);
+	bench::report_value("  p99 lookup", "ns", latencies[latencies.size() * 99 / 100] * 1e9);
+	bench::report_value("  p99.9 lookup", "ns", latencies[latencies.size() * 999 / 1000] * 1e9);
+	bench::report_value("  max lookup", "ns", latencies.back() * 1e9);
+}
+
+BENCHMARK(cuckoo_set_lookup_latency) {
+	cuckoo_lookup_latency<tinystl::unordered_set<uint64_t> >("tinystl::unordered_set");
+	cuckoo_lookup_latency<tinystl::flat_hash_set<uint64_t> >("tinystl::flat_hash_set");
+	cuckoo_lookup_latency<tinystl::cuckoo_set<uint64_t> >("tinystl::cuckoo_set");
+}
+
+BENCHMARK(cuckoo_set_insert) {
+	tinystl::cuckoo_set<uint64_t> s;
+	const double start = bench::now();
+	for (size_t ii = 0; ii < c_keys; ++ii)
+		s.insert(cuckoo_key(ii));
+	bench::report("tinystl::cuckoo_set insert", c_keys, bench::now() - start);
+	bench::report_value("  load factor", "", (double)s.size() / s.capacity());
+	bench::do_not_optimize(s);
+}
@@ -0,0 +1,88 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+
+#include <TINYSTL/deque.h>
+#include <TINYSTL/vector.h>
+
+static const size_t c_elements = 1 << 24;
+
+// Times every push_back and reports the slowest one; for vector that is
+// the last reallocation, which copies every element
+template<typename Container>
+static void deque_push(const char* name) {
+	Container c;
+	double worst = 0;
+	const double start = bench::now();
+	for (size_t ii = 0; ii < c_elements; ++ii) {
+		const double before = bench::now();
+		c.push_back(ii);
+		const double elapsed = bench::now() - before;
+		if (elapsed > worst)
+			worst = elapsed;
+	}
+	bench::report(name, c_elements, bench::now() - start);
+	bench::report_value("  slowest push", "us", worst * 1e6);
+	bench::do_not_optimize(c);
+}
+
+BENCHMARK(deque_push_back) {
+	deque_push<tinystl::vector<size_t> >("tinystl::vector");
+	deque_push<tinystl::deque<size_t> >("tinystl::deque");
+}
+
+BENCHMARK(deque_queue) {
+	tinystl::deque<size_t> d;
+	const double start = bench::now();
+	for (size_t ii = 0; ii < c_elements; ++ii) {
+		d.push_back(ii);
+		if (d.size() > 1024)
+			d.pop_front();
+	}
+	bench::report("tinystl::deque push_back/pop_front", c_elements, bench::now() - start);
+	bench::do_not_optimize(d);
+}
+
+BENCHMARK(deque_iterate) {
+	tinystl::deque<size_t> d;
+	for (size_t ii = 0; ii < c_elements; ++ii)
+		d.push_back(ii);
+
+	double start = bench::now();
+	size_t sum = 0;
+	for (tinystl::deque<size_t>::iterator it = d.begin(), end = d.end(); it != end; ++it)
+		sum += *it;
+	bench::do_not_optimize(sum);
+	bench::report("tinystl::deque iterate", c_elements, bench::now() - start);
+
+	start = bench::now();
+	sum = 0;
+	for (size_t ii = 0; ii < c_elements; ++ii)
+		sum += d[ii];
+	bench::do_not_optimize(sum);
+	bench::report("tinystl::deque index", c_elements, bench::now() - start);
+}
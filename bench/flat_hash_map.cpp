@@ -0,0 +1,78 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+
+#include <TINYSTL/flat_hash_map.h>
+#include <TINYSTL/unordered_map.h>
+
+#include <stdio.h>
+
+static const size_t c_keys = 1 << 20;
+
+// multiplying by an odd constant is a bijection, so keys are distinct but
+// scattered; indices past c_keys give keys that were never inserted
+static size_t bench_key(size_t index) {
+	return index * (size_t)0x9E3779B97F4A7C15ull;
+}
+
+template<typename Map>
+static void hash_map_bench(const char* name) {
+	char label[128];
+	Map m;
+
+	double start = bench::now();
+	for (size_t ii = 0; ii < c_keys; ++ii)
+		m.insert(tinystl::make_pair(bench_key(ii), ii));
+	snprintf(label, sizeof(label), "%s insert", name);
+	bench::report(label, c_keys, bench::now() - start);
+
+	size_t sum = 0;
+	start = bench::now();
+	for (size_t ii = 0; ii < c_keys; ++ii)
+		sum += m.find(bench_key(ii))->second;
+	snprintf(label, sizeof(label), "%s find hit", name);
+	bench::report(label, c_keys, bench::now() - start);
+
+	start = bench::now();
+	for (size_t ii = c_keys; ii < 2 * c_keys; ++ii)
+		sum += (m.find(bench_key(ii)) == m.end());
+	snprintf(label, sizeof(label), "%s find miss", name);
+	bench::report(label, c_keys, bench::now() - start);
+	bench::do_not_optimize(sum);
+
+	start = bench::now();
+	for (size_t ii = 0; ii < c_keys; ++ii)
+		m.erase(m.find(bench_key(ii)));
+	snprintf(label, sizeof(label), "%s erase", name);
+	bench::report(label, c_keys, bench::now() - start);
+	bench::do_not_optimize(m);
+}
+
+BENCHMARK(flat_hash_map) {
+	hash_map_bench<tinystl::unordered_map<size_t, size_t> >("tinystl::unordered_map");
+	hash_map_bench<tinystl::flat_hash_map<size_t, size_t> >("tinystl::flat_hash_map");
+}
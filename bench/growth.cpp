@@ -0,0 +1,97 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+
+#include <TINYSTL/growth.h>
+#include <TINYSTL/string.h>
+#include <TINYSTL/tracking_allocator.h>
+#include <TINYSTL/vector.h>
+
+static const size_t c_elements = 8 * 1024 * 1024;
+static const size_t c_chars = 16 * 1024 * 1024;
+
+template<typename Policy>
+struct growth_tag {};
+
+struct growth_default_tag {};
+
+template<typename Tag>
+static void growth_report(const char* name, double seconds, size_t ops) {
+	const tinystl::tracking_counts counts = tinystl::tracking_tag_counts<Tag>();
+	bench::report(name, ops, seconds);
+	bench::report_value("  allocations", "calls", (double)counts.allocations);
+	bench::report_value("  in-place reallocations", "calls", (double)counts.reallocations);
+	bench::report_value("  peak", "MB", (double)counts.peak_bytes / (1024 * 1024));
+}
+
+template<typename Tag, typename Alloc>
+static void growth_vector(const char* name) {
+	const double start = bench::now();
+	{
+		tinystl::vector<size_t, Alloc> v;
+		for (size_t ii = 0; ii < c_elements; ++ii)
+			v.push_back(ii);
+		bench::do_not_optimize(v);
+	}
+	growth_report<Tag>(name, bench::now() - start, c_elements);
+}
+
+template<typename Tag, typename Alloc>
+static void growth_string(const char* name) {
+	const char* text = "0123456789abcdef";
+	const double start = bench::now();
+	{
+		tinystl::basic_string<Alloc> s;
+		for (size_t ii = 0; ii < c_chars; ii += 16)
+			s.append(text, text + 16);
+		bench::do_not_optimize(s);
+	}
+	growth_report<Tag>(name, bench::now() - start, c_chars / 16);
+}
+
+template<typename Policy>
+struct growth_policy_allocator : tinystl::growth_allocator<Policy, tinystl::tracking_allocator<growth_tag<Policy> > > {
+};
+
+BENCHMARK(growth_vector_push_back) {
+	using namespace tinystl;
+	growth_vector<growth_default_tag, tracking_allocator<growth_default_tag> >("default (1.5x required)");
+	growth_vector<growth_tag<growth_factor<2, 1> >, growth_policy_allocator<growth_factor<2, 1> > >("growth_factor<2, 1>");
+	growth_vector<growth_tag<growth_factor<5, 4> >, growth_policy_allocator<growth_factor<5, 4> > >("growth_factor<5, 4>");
+	growth_vector<growth_tag<growth_page_granular<> >, growth_policy_allocator<growth_page_granular<> > >("growth_page_granular<>");
+}
+
+struct growth_string_default_tag {};
+struct growth_string_double_tag {};
+struct growth_string_tight_tag {};
+
+BENCHMARK(growth_string_append) {
+	using namespace tinystl;
+	growth_string<growth_string_default_tag, tracking_allocator<growth_string_default_tag> >("default (1.5x required)");
+	growth_string<growth_string_double_tag, growth_allocator<growth_factor<2, 1>, tracking_allocator<growth_string_double_tag> > >("growth_factor<2, 1>");
+	growth_string<growth_string_tight_tag, growth_allocator<growth_factor<5, 4>, tracking_allocator<growth_string_tight_tag> > >("growth_factor<5, 4>");
+}
@@ -0,0 +1,93 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+
+#include <TINYSTL/hash.h>
+#include <TINYSTL/string.h>
+#include <TINYSTL/unordered_map.h>
+
+#include <stdio.h>
+
+// The byte-at-a-time sdbm hash that hash_string used to be
+static size_t sdbm_hash(const char* str, size_t len) {
+	size_t hash = 0;
+	for (const char* it = str, *end = str + len; it != end; ++it)
+		hash = *it + (hash << 6) + (hash << 16) - hash;
+	return hash;
+}
+
+static const size_t c_bytes_per_length = 64 << 20;
+
+template<size_t (*Hash)(const char*, size_t)>
+static void hash_throughput(const char* name) {
+	static char buffer[4096 + 64];
+	for (size_t ii = 0; ii < sizeof(buffer); ++ii)
+		buffer[ii] = (char)(ii * 131 + 17);
+
+	for (size_t len = 4; len <= 4096; len *= 2) {
+		const size_t count = c_bytes_per_length / len;
+		size_t sum = 0;
+		const double start = bench::now();
+		for (size_t ii = 0; ii < count; ++ii) {
+			// vary the start so each hash reads different bytes
+			sum += Hash(buffer + (ii & 63), len);
+		}
+		const double seconds = bench::now() - start;
+		bench::do_not_optimize(sum);
+
+		char label[64];
+		snprintf(label, sizeof(label), "%s %zu bytes", name, len);
+		bench::report_value(label, "GB/s", (double)(count * len) / seconds / 1e9);
+	}
+}
+
+BENCHMARK(hash_string_throughput) {
+	hash_throughput<sdbm_hash>("sdbm");
+	hash_throughput<tinystl::hash_string>("tinystl::hash_string");
+}
+
+BENCHMARK(hash_string_map_lookup) {
+	static const size_t c_keys = 1 << 14;
+	static const size_t c_lookups = 1 << 22;
+
+	tinystl::unordered_map<tinystl::string, size_t> m;
+	tinystl::string* keys = new tinystl::string[c_keys];
+	char buffer[160];
+	for (size_t ii = 0; ii < c_keys; ++ii) {
+		snprintf(buffer, sizeof(buffer), "/api/v2/accounts/%08zx/resources/by-name/a-resource-name-long-enough-to-make-the-key-about-128-bytes/revision/%zu", ii * 2654435761u, ii);
+		keys[ii] = buffer;
+		m[keys[ii]] = ii;
+	}
+
+	size_t sum = 0;
+	const double start = bench::now();
+	for (size_t ii = 0; ii < c_lookups; ++ii)
+		sum += m.find(keys[(ii * 7919) & (c_keys - 1)])->second;
+	bench::report("unordered_map<string> find, 128 byte keys", c_lookups, bench::now() - start);
+	bench::do_not_optimize(sum);
+	delete[] keys;
+}
@@ -0,0 +1,69 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+
+#include <TINYSTL/hugepage_allocator.h>
+#include <TINYSTL/vector.h>
+#include <stdio.h>
+
+static const size_t c_elements = 64 * 1024 * 1024;
+static const size_t c_lookups = 16 * 1024 * 1024;
+
+template<typename Alloc>
+static void scan(const char* name) {
+	tinystl::vector<size_t, Alloc> v;
+	v.resize(c_elements);
+	for (size_t ii = 0; ii < c_elements; ++ii)
+		v[ii] = ii;
+
+	double start = bench::now();
+	size_t sum = 0;
+	for (size_t ii = 0; ii < c_elements; ++ii)
+		sum += v[ii];
+	bench::do_not_optimize(sum);
+
+	char label[96];
+	snprintf(label, sizeof(label), "%s, sequential", name);
+	bench::report(label, c_elements, bench::now() - start);
+
+	// random gathers touch a new page almost every access
+	start = bench::now();
+	size_t index = 0;
+	for (size_t ii = 0; ii < c_lookups; ++ii) {
+		index = (index * 6364136223846793005ull + 1442695040888963407ull) & (c_elements - 1);
+		sum += v[index];
+	}
+	bench::do_not_optimize(sum);
+
+	snprintf(label, sizeof(label), "%s, random", name);
+	bench::report(label, c_lookups, bench::now() - start);
+}
+
+BENCHMARK(hugepage_scan) {
+	scan<tinystl::allocator>("tinystl::allocator");
+	scan<tinystl::hugepage_allocator>("tinystl::hugepage_allocator");
+}
@@ -0,0 +1,78 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+
+static bench::benchmark* s_benchmarks;
+
+bench::benchmark::benchmark(const char* name_, void (*fn_)())
+	: name(name_)
+	, fn(fn_)
+	, next(s_benchmarks)
+{
+	s_benchmarks = this;
+}
+
+double bench::now() {
+	typedef std::chrono::steady_clock clock;
+	return std::chrono::duration<double>(clock::now().time_since_epoch()).count();
+}
+
+void bench::report(const char* name, size_t ops, double seconds) {
+	printf("  %-48s %10.2f Mops/s %10.2f ns/op\n", name, (double)ops / seconds / 1e6, seconds * 1e9 / (double)ops);
+}
+
+void bench::report_value(const char* name, const char* unit, double value) {
+	printf("  %-48s %14.2f %s\n", name, value, unit);
+}
+
+// usage: bench_tinystl [filter]
+// Runs every benchmark whose name contains filter (or all of them).
+int main(int argc, char** argv) {
+	const char* filter = (argc > 1) ? argv[1] : "";
+
+	bench::benchmark* list = 0;
+	while (s_benchmarks) {
+		bench::benchmark* next = s_benchmarks->next;
+		s_benchmarks->next = list;
+		list = s_benchmarks;
+		s_benchmarks = next;
+	}
+
+	for (bench::benchmark* it = list; it; it = it->next) {
+		if (!strstr(it->name, filter))
+			continue;
+
+		printf("%s\n", it->name);
+		it->fn();
+	}
+
+	return 0;
+}
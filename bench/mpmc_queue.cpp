@@ -0,0 +1,140 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+
+#include <TINYSTL/atomic.h>
+#include <TINYSTL/mpmc_queue.h>
+
+#include <algorithm>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+static const size_t c_items_per_producer = 1 << 18;
+
+static void mpmc_wait(unsigned* spins) {
+	if (++*spins < 256)
+		tinystl::atomic_pause();
+	else
+		std::this_thread::yield();
+}
+
+// Times every push, including time spent waiting for room
+static void mpmc_produce(tinystl::mpmc_queue<size_t>* queue, std::vector<double>* latencies) {
+	latencies->reserve(c_items_per_producer);
+	for (size_t ii = 0; ii < c_items_per_producer; ++ii) {
+		unsigned spins = 0;
+		const double start = bench::now();
+		while (!queue->push(ii))
+			mpmc_wait(&spins);
+		latencies->push_back(bench::now() - start);
+	}
+}
+
+static void mpmc_consume(tinystl::mpmc_queue<size_t>* queue, size_t* remaining) {
+	size_t value, sum = 0;
+	unsigned spins = 0;
+	for (;;) {
+		if (queue->pop(value)) {
+			sum += value;
+			spins = 0;
+			if (tinystl::atomic_fetch_add(remaining, (size_t)-1) == 1)
+				break;
+		} else if (!tinystl::atomic_load_relaxed(remaining)) {
+			break;
+		} else {
+			mpmc_wait(&spins);
+		}
+	}
+	bench::do_not_optimize(sum);
+}
+
+static void mpmc_run(unsigned nproducers, unsigned nconsumers) {
+	tinystl::mpmc_queue<size_t> queue(1024);
+	size_t remaining = nproducers * c_items_per_producer;
+
+	std::vector<std::vector<double> > latencies(nproducers);
+	std::vector<std::thread> threads;
+	const double start = bench::now();
+	for (unsigned ii = 0; ii < nconsumers; ++ii)
+		threads.push_back(std::thread(mpmc_consume, &queue, &remaining));
+	for (unsigned ii = 0; ii < nproducers; ++ii)
+		threads.push_back(std::thread(mpmc_produce, &queue, &latencies[ii]));
+	for (size_t ii = 0; ii < threads.size(); ++ii)
+		threads[ii].join();
+	const double seconds = bench::now() - start;
+
+	std::vector<double> all;
+	for (unsigned ii = 0; ii < nproducers; ++ii)
+		all.insert(all.end(), latencies[ii].begin(), latencies[ii].end());
+	std::sort(all.begin(), all.end());
+
+	char label[64];
+	snprintf(label, sizeof(label), "%u producers, %u consumers", nproducers, nconsumers);
+	bench::report(label, nproducers * c_items_per_producer, seconds);
+	bench::report_value("  p99 enqueue", "ns", all[all.size() * 99 / 100] * 1e9);
+}
+
+// Uncontended baseline: one thread pushes and pops each item in turn
+static void mpmc_run_single() {
+	tinystl::mpmc_queue<size_t> queue(1024);
+
+	std::vector<double> latencies;
+	latencies.reserve(c_items_per_producer);
+	size_t value = 0, sum = 0;
+	const double start = bench::now();
+	for (size_t ii = 0; ii < c_items_per_producer; ++ii) {
+		const double before = bench::now();
+		queue.push(ii);
+		latencies.push_back(bench::now() - before);
+		queue.pop(value);
+		sum += value;
+	}
+	const double seconds = bench::now() - start;
+	bench::do_not_optimize(sum);
+
+	std::sort(latencies.begin(), latencies.end());
+	bench::report("1 thread, push then pop", c_items_per_producer, seconds);
+	bench::report_value("  p99 enqueue", "ns", latencies[latencies.size() * 99 / 100] * 1e9);
+}
+
+BENCHMARK(mpmc_queue_contention) {
+	mpmc_run_single();
+
+	unsigned maxthreads = std::thread::hardware_concurrency();
+	if (maxthreads < 2)
+		maxthreads = 2;
+
+	for (unsigned nthreads = 2; ; nthreads *= 2) {
+		if (nthreads > maxthreads)
+			nthreads = maxthreads;
+
+		mpmc_run(nthreads / 2, nthreads - nthreads / 2);
+		if (nthreads == maxthreads)
+			break;
+	}
+}
@@ -0,0 +1,102 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+
+#include <TINYSTL/string.h>
+#include <TINYSTL/vector.h>
+#include <string.h>
+
+static const size_t c_bytes = 64 * 1024 * 1024;
+static const size_t c_rounds = 8;
+
+// stands in for read() or a decoder writing every byte
+static void overwrite(void* data, size_t bytes) {
+	memset(data, 0x5a, bytes);
+	bench::do_not_optimize(data);
+}
+
+BENCHMARK(resize_vector_overwrite) {
+	double start = bench::now();
+	for (size_t rr = 0; rr < c_rounds; ++rr) {
+		tinystl::vector<unsigned char> v;
+		v.resize(c_bytes);
+		overwrite(v.data(), v.size());
+	}
+	bench::report_value("resize + overwrite", "GB/s", (double)(c_rounds * c_bytes) / (bench::now() - start) / 1e9);
+
+	start = bench::now();
+	for (size_t rr = 0; rr < c_rounds; ++rr) {
+		tinystl::vector<unsigned char> v;
+		v.resize_uninitialized(c_bytes);
+		overwrite(v.data(), v.size());
+	}
+	bench::report_value("resize_uninitialized + overwrite", "GB/s", (double)(c_rounds * c_bytes) / (bench::now() - start) / 1e9);
+}
+
+BENCHMARK(resize_vector_float_overwrite) {
+	const size_t count = c_bytes / sizeof(float);
+
+	// reuse one warm block so only the zeroing pass differs
+	tinystl::vector<float> v;
+	v.reserve(count);
+
+	double start = bench::now();
+	for (size_t rr = 0; rr < c_rounds; ++rr) {
+		v.clear();
+		v.resize(count);
+		overwrite(v.data(), count * sizeof(float));
+	}
+	bench::report_value("resize + overwrite (warm)", "GB/s", (double)(c_rounds * c_bytes) / (bench::now() - start) / 1e9);
+
+	start = bench::now();
+	for (size_t rr = 0; rr < c_rounds; ++rr) {
+		v.clear();
+		v.resize_uninitialized(count);
+		overwrite(v.data(), count * sizeof(float));
+	}
+	bench::report_value("resize_uninitialized + overwrite (warm)", "GB/s", (double)(c_rounds * c_bytes) / (bench::now() - start) / 1e9);
+}
+
+BENCHMARK(resize_string_overwrite) {
+	const size_t bytes = c_bytes / 16;
+
+	double start = bench::now();
+	for (size_t rr = 0; rr < c_rounds * 4; ++rr) {
+		tinystl::string s;
+		s.resize(bytes);
+		overwrite(s.data(), s.size());
+	}
+	bench::report_value("resize + overwrite", "GB/s", (double)(c_rounds * 4 * bytes) / (bench::now() - start) / 1e9);
+
+	start = bench::now();
+	for (size_t rr = 0; rr < c_rounds * 4; ++rr) {
+		tinystl::string s;
+		s.resize_uninitialized(bytes);
+		overwrite(s.data(), s.size());
+	}
+	bench::report_value("resize_uninitialized + overwrite", "GB/s", (double)(c_rounds * 4 * bytes) / (bench::now() - start) / 1e9);
+}
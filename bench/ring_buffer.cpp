@@ -0,0 +1,92 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+
+#include <TINYSTL/ring_buffer.h>
+#include <TINYSTL/vector.h>
+#include <string.h>
+
+static const size_t c_operations = 1 << 20;
+
+// Steady-state work queue holding depth items: push one, pop one
+static void ring_fifo(size_t depth) {
+	tinystl::vector<size_t> v;
+	for (size_t ii = 0; ii < depth; ++ii)
+		v.push_back(ii);
+
+	double start = bench::now();
+	for (size_t ii = 0; ii < c_operations; ++ii) {
+		v.push_back(ii);
+		v.erase(v.begin());
+	}
+	bench::report("tinystl::vector erase(begin())", c_operations, bench::now() - start);
+	bench::do_not_optimize(v);
+
+	tinystl::ring_buffer<size_t> r;
+	for (size_t ii = 0; ii < depth; ++ii)
+		r.push_back(ii);
+
+	start = bench::now();
+	for (size_t ii = 0; ii < c_operations; ++ii) {
+		r.push_back(ii);
+		r.pop_front();
+	}
+	bench::report("tinystl::ring_buffer", c_operations, bench::now() - start);
+	bench::do_not_optimize(r);
+}
+
+BENCHMARK(ring_buffer_fifo_depth_64) {
+	ring_fifo(64);
+}
+
+BENCHMARK(ring_buffer_fifo_depth_4096) {
+	ring_fifo(4096);
+}
+
+// Producer appends 1500 byte packets, consumer drains both spans with memcpy
+BENCHMARK(ring_buffer_bulk_bytes) {
+	static const size_t packet = 1500;
+	char payload[packet];
+	char out[64 * 1024];
+	memset(payload, 0x5a, sizeof(payload));
+
+	tinystl::ring_buffer<char> r;
+	const double start = bench::now();
+	for (size_t ii = 0; ii < c_operations / 8; ++ii) {
+		if (r.size() + packet > sizeof(out)) {
+			const tinystl::ring_span<char> first = r.first_span(), second = r.second_span();
+			memcpy(out, first.first, first.size());
+			memcpy(out + first.size(), second.first, second.size());
+			bench::do_not_optimize(out);
+			r.pop_front(r.size() / 2);
+		}
+		r.push_back(payload, payload + packet);
+	}
+	const double seconds = bench::now() - start;
+	bench::report("tinystl::ring_buffer packets", c_operations / 8, seconds);
+	bench::report_value("  throughput", "MB/s", (double)(c_operations / 8) * packet / seconds / (1024 * 1024));
+}
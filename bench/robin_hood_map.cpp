@@ -0,0 +1,103 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+
+#include <TINYSTL/flat_hash_map.h>
+#include <TINYSTL/robin_hood_map.h>
+#include <TINYSTL/tracking_allocator.h>
+#include <TINYSTL/unordered_map.h>
+
+#include <stdint.h>
+#include <stdio.h>
+
+// 0.9 of a 2^20 slot table, so the open-addressing maps run at their
+// highest load factor
+static const size_t c_keys = (1 << 20) - (1 << 20) / 10;
+
+static uint64_t robin_hood_key(size_t index) {
+	return (uint64_t)index * 0x9E3779B97F4A7C15ull;
+}
+
+template<typename Map, typename Tag>
+static void robin_hood_bench(const char* name) {
+	char label[128];
+	Map m;
+
+	double start = bench::now();
+	for (size_t ii = 0; ii < c_keys; ++ii)
+		m.insert(tinystl::make_pair(robin_hood_key(ii), (uint64_t)ii));
+	snprintf(label, sizeof(label), "%s insert", name);
+	bench::report(label, c_keys, bench::now() - start);
+	bench::report_value("  memory per entry", "bytes", (double)tinystl::tracking_tag_counts<Tag>().live_bytes / c_keys);
+
+	uint64_t sum = 0;
+	start = bench::now();
+	for (size_t ii = 0; ii < c_keys; ++ii)
+		sum += m.find(robin_hood_key(ii))->second;
+	snprintf(label, sizeof(label), "%s find hit", name);
+	bench::report(label, c_keys, bench::now() - start);
+
+	start = bench::now();
+	for (size_t ii = c_keys; ii < 2 * c_keys; ++ii)
+		sum += (m.find(robin_hood_key(ii)) == m.end());
+	snprintf(label, sizeof(label), "%s find miss", name);
+	bench::report(label, c_keys, bench::now() - start);
+	bench::do_not_optimize(sum);
+
+	start = bench::now();
+	for (size_t ii = 0; ii < c_keys; ++ii)
+		m.erase(m.find(robin_hood_key(ii)));
+	snprintf(label, sizeof(label), "%s erase", name);
+	bench::report(label, c_keys, bench::now() - start);
+	bench::do_not_optimize(m);
+}
+
+struct robin_hood_bench_chained {};
+struct robin_hood_bench_flat {};
+struct robin_hood_bench_robin {};
+
+BENCHMARK(robin_hood_map) {
+	robin_hood_bench<tinystl::unordered_map<uint64_t, uint64_t, tinystl::tracking_allocator<robin_hood_bench_chained> >, robin_hood_bench_chained>("tinystl::unordered_map");
+	robin_hood_bench<tinystl::flat_hash_map<uint64_t, uint64_t, tinystl::tracking_allocator<robin_hood_bench_flat> >, robin_hood_bench_flat>("tinystl::flat_hash_map");
+	robin_hood_bench<tinystl::robin_hood_map<uint64_t, uint64_t, tinystl::tracking_allocator<robin_hood_bench_robin> >, robin_hood_bench_robin>("tinystl::robin_hood_map");
+}
+
+BENCHMARK(robin_hood_map_probe_length) {
+	tinystl::robin_hood_map<uint64_t, uint64_t> m;
+	for (size_t ii = 0; ii < c_keys; ++ii)
+		m[robin_hood_key(ii)] = ii;
+
+	size_t total = 0, longest = 0;
+	for (tinystl::robin_hood_map<uint64_t, uint64_t>::iterator it = m.begin(); it != m.end(); ++it) {
+		total += *it.distance;
+		if (*it.distance > longest)
+			longest = *it.distance;
+	}
+	bench::report_value("load factor", "", (double)m.size() / m.capacity());
+	bench::report_value("mean probe length", "slots", (double)total / m.size());
+	bench::report_value("longest probe", "slots", (double)longest);
+}
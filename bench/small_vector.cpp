@@ -0,0 +1,85 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+
+#include <TINYSTL/small_vector.h>
+#include <TINYSTL/tracking_allocator.h>
+#include <TINYSTL/vector.h>
+
+static const size_t c_vectors = 1000000;
+
+struct small_bench_vector_tag {};
+struct small_bench_small_tag {};
+
+template<typename Vector, typename Tag>
+static void small_build(const char* name, size_t maxsize) {
+	const size_t before = tinystl::tracking_tag_counts<Tag>().allocations;
+	const double start = bench::now();
+	for (size_t ii = 0; ii < c_vectors; ++ii) {
+		Vector v;
+		const size_t count = 1 + (ii * 7) % maxsize;
+		for (size_t jj = 0; jj < count; ++jj)
+			v.push_back((int)jj);
+		bench::do_not_optimize(v);
+	}
+	const double seconds = bench::now() - start;
+	bench::report(name, c_vectors, seconds);
+	bench::report_value("  heap allocations per vector", "calls", (double)(tinystl::tracking_tag_counts<Tag>().allocations - before) / c_vectors);
+}
+
+BENCHMARK(small_vector_build_upto_8) {
+	small_build<tinystl::vector<int, tinystl::tracking_allocator<small_bench_vector_tag> >, small_bench_vector_tag>("tinystl::vector", 8);
+	small_build<tinystl::small_vector<int, 8, tinystl::tracking_allocator<small_bench_small_tag> >, small_bench_small_tag>("tinystl::small_vector<8>", 8);
+}
+
+BENCHMARK(small_vector_build_upto_32) {
+	small_build<tinystl::vector<int, tinystl::tracking_allocator<small_bench_vector_tag> >, small_bench_vector_tag>("tinystl::vector", 32);
+	small_build<tinystl::small_vector<int, 8, tinystl::tracking_allocator<small_bench_small_tag> >, small_bench_small_tag>("tinystl::small_vector<8>", 32);
+}
+
+BENCHMARK(small_vector_copy) {
+	tinystl::vector<int> source;
+	tinystl::small_vector<int, 8> smallsource;
+	for (int ii = 0; ii < 6; ++ii) {
+		source.push_back(ii);
+		smallsource.push_back(ii);
+	}
+
+	double start = bench::now();
+	for (size_t ii = 0; ii < c_vectors; ++ii) {
+		tinystl::vector<int> v(source);
+		bench::do_not_optimize(v);
+	}
+	bench::report("tinystl::vector", c_vectors, bench::now() - start);
+
+	start = bench::now();
+	for (size_t ii = 0; ii < c_vectors; ++ii) {
+		tinystl::small_vector<int, 8> v(smallsource);
+		bench::do_not_optimize(v);
+	}
+	bench::report("tinystl::small_vector<8>", c_vectors, bench::now() - start);
+}
@@ -0,0 +1,150 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+
+#include <TINYSTL/atomic.h>
+#include <TINYSTL/ring_buffer.h>
+#include <TINYSTL/spsc_queue.h>
+
+#include <mutex>
+#include <thread>
+
+static const size_t c_roundtrips = 200000;
+static const size_t c_items = 1 << 22;
+
+// Spins briefly, then yields so the benchmark still progresses when both
+// threads share a core
+static void spsc_wait(unsigned* spins) {
+	if (++*spins < 256)
+		tinystl::atomic_pause();
+	else
+		std::this_thread::yield();
+}
+
+// One message bounces between two threads through a pair of queues
+static void spsc_pong(tinystl::spsc_queue<size_t>* ping, tinystl::spsc_queue<size_t>* pong) {
+	size_t value;
+	for (size_t ii = 0; ii < c_roundtrips; ++ii) {
+		unsigned spins = 0;
+		while (!ping->pop(value))
+			spsc_wait(&spins);
+		while (!pong->push(value + 1))
+			spsc_wait(&spins);
+	}
+}
+
+BENCHMARK(spsc_queue_pingpong) {
+	tinystl::spsc_queue<size_t> ping(64), pong(64);
+	std::thread other(spsc_pong, &ping, &pong);
+
+	size_t value = 0;
+	const double start = bench::now();
+	for (size_t ii = 0; ii < c_roundtrips; ++ii) {
+		unsigned spins = 0;
+		while (!ping.push(value))
+			spsc_wait(&spins);
+		while (!pong.pop(value))
+			spsc_wait(&spins);
+	}
+	const double seconds = bench::now() - start;
+	other.join();
+
+	bench::do_not_optimize(value);
+	bench::report("tinystl::spsc_queue round trip", c_roundtrips, seconds);
+	bench::report_value("  one-way latency", "ns", seconds * 1e9 / c_roundtrips / 2);
+}
+
+static void spsc_consume(tinystl::spsc_queue<size_t>* queue, size_t batch) {
+	size_t items[64];
+	size_t sum = 0;
+	unsigned spins = 0;
+	for (size_t received = 0; received < c_items; ) {
+		const size_t count = queue->pop(items, items + batch);
+		if (!count)
+			spsc_wait(&spins);
+		else
+			spins = 0;
+		for (size_t ii = 0; ii < count; ++ii)
+			sum += items[ii];
+		received += count;
+	}
+	bench::do_not_optimize(sum);
+}
+
+static void spsc_stream(const char* name, size_t batch) {
+	tinystl::spsc_queue<size_t> queue(4096);
+	std::thread consumer(spsc_consume, &queue, batch);
+
+	size_t items[64];
+	unsigned spins = 0;
+	const double start = bench::now();
+	for (size_t sent = 0; sent < c_items; ) {
+		size_t count = c_items - sent;
+		if (count > batch)
+			count = batch;
+		for (size_t ii = 0; ii < count; ++ii)
+			items[ii] = sent + ii;
+
+		const size_t pushed = queue.push(items, items + count);
+		if (!pushed)
+			spsc_wait(&spins);
+		else
+			spins = 0;
+		sent += pushed;
+	}
+	consumer.join();
+	bench::report(name, c_items, bench::now() - start);
+}
+
+BENCHMARK(spsc_queue_throughput) {
+	spsc_stream("tinystl::spsc_queue", 1);
+	spsc_stream("tinystl::spsc_queue, batches of 64", 64);
+
+	// the mutex-guarded queue this replaces
+	std::mutex lock;
+	tinystl::ring_buffer<size_t> queue;
+	std::thread consumer([&lock, &queue]() {
+		size_t sum = 0;
+		for (size_t received = 0; received < c_items; ) {
+			std::lock_guard<std::mutex> guard(lock);
+			if (!queue.empty()) {
+				sum += queue.front();
+				queue.pop_front();
+				++received;
+			}
+		}
+		bench::do_not_optimize(sum);
+	});
+
+	const double start = bench::now();
+	for (size_t ii = 0; ii < c_items; ++ii) {
+		std::lock_guard<std::mutex> guard(lock);
+		queue.push_back(ii);
+	}
+	consumer.join();
+	bench::report("std::mutex + tinystl::ring_buffer", c_items, bench::now() - start);
+}
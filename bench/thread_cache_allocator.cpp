@@ -0,0 +1,84 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+
+#include <TINYSTL/thread_cache_allocator.h>
+#include <TINYSTL/unordered_map.h>
+#include <TINYSTL/vector.h>
+
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+static const size_t c_iterations = 20000;
+
+template<typename Alloc>
+static void churn() {
+	for (size_t ii = 0; ii < c_iterations; ++ii) {
+		tinystl::vector<size_t, Alloc> v;
+		for (size_t jj = 0; jj < 64; ++jj)
+			v.push_back(jj);
+
+		tinystl::unordered_map<size_t, size_t, Alloc> m;
+		for (size_t jj = 0; jj < 16; ++jj)
+			m.insert(tinystl::make_pair(jj, jj));
+
+		bench::do_not_optimize(v);
+		bench::do_not_optimize(m);
+	}
+}
+
+template<typename Alloc>
+static void run(const char* name, unsigned nthreads) {
+	std::vector<std::thread> threads;
+	const double start = bench::now();
+	for (unsigned ii = 0; ii < nthreads; ++ii)
+		threads.push_back(std::thread(churn<Alloc>));
+	for (unsigned ii = 0; ii < nthreads; ++ii)
+		threads[ii].join();
+
+	char label[64];
+	snprintf(label, sizeof(label), "%s, %u threads", name, nthreads);
+	bench::report(label, c_iterations * nthreads, bench::now() - start);
+}
+
+BENCHMARK(thread_cache_scaling) {
+	unsigned maxthreads = std::thread::hardware_concurrency();
+	if (maxthreads < 1)
+		maxthreads = 1;
+
+	for (unsigned nthreads = 1; ; nthreads *= 2) {
+		if (nthreads > maxthreads)
+			nthreads = maxthreads;
+
+		run<tinystl::allocator>("tinystl::allocator", nthreads);
+		run<tinystl::thread_cache_allocator>("tinystl::thread_cache_allocator", nthreads);
+
+		if (nthreads == maxthreads)
+			break;
+	}
+}
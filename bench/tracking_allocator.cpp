@@ -0,0 +1,73 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+
+#include <TINYSTL/tracking_allocator.h>
+#include <TINYSTL/unordered_map.h>
+#include <TINYSTL/vector.h>
+
+static const size_t c_requests = 20000;
+static const size_t c_elements = 256;
+
+struct tracking_bench_tag {
+	static const char* name() { return "bench"; }
+};
+
+template<typename Alloc>
+static void tracking_vector_growth(const char* name) {
+	const double start = bench::now();
+	for (size_t rr = 0; rr < c_requests; ++rr) {
+		tinystl::vector<size_t, Alloc> v;
+		for (size_t ii = 0; ii < c_elements; ++ii)
+			v.push_back(ii);
+		bench::do_not_optimize(v);
+	}
+	bench::report(name, c_requests * c_elements, bench::now() - start);
+}
+
+template<typename Alloc>
+static void tracking_hashmap_insert(const char* name) {
+	const double start = bench::now();
+	for (size_t rr = 0; rr < c_requests / 4; ++rr) {
+		tinystl::unordered_map<size_t, size_t, Alloc> m;
+		for (size_t ii = 0; ii < c_elements; ++ii)
+			m.insert(tinystl::make_pair(ii, ii));
+		bench::do_not_optimize(m);
+	}
+	bench::report(name, c_requests / 4 * c_elements, bench::now() - start);
+}
+
+BENCHMARK(tracking_vector_growth) {
+	tracking_vector_growth<tinystl::allocator>("tinystl::allocator");
+	tracking_vector_growth<tinystl::tracking_allocator<tracking_bench_tag> >("tinystl::tracking_allocator");
+}
+
+BENCHMARK(tracking_hashmap_insert) {
+	tracking_hashmap_insert<tinystl::allocator>("tinystl::allocator");
+	tracking_hashmap_insert<tinystl::tracking_allocator<tracking_bench_tag> >("tinystl::tracking_allocator");
+	bench::report_value("tracked allocations", "calls", (double)tinystl::tracking_tag_counts<tracking_bench_tag>().allocations);
+}
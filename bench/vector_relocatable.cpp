@@ -0,0 +1,124 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+
+#include <TINYSTL/string.h>
+#include <TINYSTL/vector.h>
+
+static const size_t c_elements = 4096;
+static const size_t c_rounds = 20;
+
+struct large_copyable {
+	large_copyable() { data[0] = 0; }
+	large_copyable(size_t v) { data[0] = v; }
+	large_copyable(const large_copyable& other) { for (size_t ii = 0; ii < 16; ++ii) data[ii] = other.data[ii]; }
+	large_copyable& operator=(const large_copyable& other) { for (size_t ii = 0; ii < 16; ++ii) data[ii] = other.data[ii]; return *this; }
+
+	size_t data[16];
+};
+
+struct large_relocatable : large_copyable {
+	typedef large_relocatable tinystl_relocatable;
+
+	large_relocatable() {}
+	large_relocatable(size_t v) : large_copyable(v) {}
+};
+
+// wraps a vector but hides it from the relocation trait
+struct opaque_vector {
+	opaque_vector() {}
+	opaque_vector(size_t v) { inner.push_back(v); }
+	opaque_vector(const opaque_vector& other) : inner(other.inner) {}
+	opaque_vector(opaque_vector&& other) : inner(static_cast<tinystl::vector<size_t>&&>(other.inner)) {}
+	opaque_vector& operator=(const opaque_vector& other) { inner = other.inner; return *this; }
+	void swap(opaque_vector& other) { inner.swap(other.inner); }
+
+	tinystl::vector<size_t> inner;
+};
+
+template<typename T>
+static T make_element(size_t ii) {
+	return T(ii);
+}
+
+template<>
+tinystl::vector<size_t> make_element<tinystl::vector<size_t> >(size_t ii) {
+	tinystl::vector<size_t> v;
+	v.push_back(ii);
+	return v;
+}
+
+template<>
+tinystl::string make_element<tinystl::string>(size_t ii) {
+	char buffer[32] = "a string too long for sso ";
+	buffer[26] = (char)('a' + ii % 26);
+	return tinystl::string(buffer, 27);
+}
+
+template<typename T>
+static void relocate_growth(const char* name) {
+	const double start = bench::now();
+	for (size_t rr = 0; rr < c_rounds * 10; ++rr) {
+		tinystl::vector<T> v;
+		for (size_t ii = 0; ii < c_elements; ++ii)
+			v.push_back(make_element<T>(ii));
+		bench::do_not_optimize(v);
+	}
+	bench::report(name, c_rounds * 10 * c_elements, bench::now() - start);
+}
+
+template<typename T>
+static void relocate_front(const char* name) {
+	tinystl::vector<T> v;
+	for (size_t ii = 0; ii < c_elements; ++ii)
+		v.push_back(make_element<T>(ii));
+
+	const T value = make_element<T>(0);
+	const double start = bench::now();
+	for (size_t rr = 0; rr < c_rounds * 50; ++rr) {
+		v.insert(v.begin(), value);
+		v.erase(v.begin());
+	}
+	bench::do_not_optimize(v);
+	bench::report(name, c_rounds * 50 * 2, bench::now() - start);
+}
+
+BENCHMARK(relocate_vector_growth) {
+	relocate_growth<large_copyable>("large struct, copied");
+	relocate_growth<large_relocatable>("large struct, relocated");
+	relocate_growth<opaque_vector>("vector<size_t>, moved");
+	relocate_growth<tinystl::vector<size_t> >("vector<size_t>, relocated");
+	relocate_growth<tinystl::string>("tinystl::string, moved");
+}
+
+BENCHMARK(relocate_vector_insert_erase_front) {
+	relocate_front<large_copyable>("large struct, copied");
+	relocate_front<large_relocatable>("large struct, relocated");
+	relocate_front<opaque_vector>("vector<size_t>, moved");
+	relocate_front<tinystl::vector<size_t> >("vector<size_t>, relocated");
+	relocate_front<tinystl::string>("tinystl::string, moved");
+}
@@ -0,0 +1,72 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+
+#include <TINYSTL/vector.h>
+#include <TINYSTL/vm_vector.h>
+
+static const size_t c_records = 1 << 26;
+
+// Appends c_records 8-byte records, timing every push so the report shows
+// the stall when vector copies itself into a larger block
+template<typename Container>
+static void vm_append(const char* name) {
+	Container c;
+	double worst = 0;
+	const double start = bench::now();
+	for (size_t ii = 0; ii < c_records; ++ii) {
+		const double before = bench::now();
+		c.push_back(ii);
+		const double elapsed = bench::now() - before;
+		if (elapsed > worst)
+			worst = elapsed;
+	}
+	bench::report(name, c_records, bench::now() - start);
+	bench::report_value("  slowest append", "us", worst * 1e6);
+	bench::do_not_optimize(c);
+}
+
+// Appends without per-operation timing to measure raw throughput
+template<typename Container>
+static void vm_append_throughput(const char* name) {
+	Container c;
+	const double start = bench::now();
+	for (size_t ii = 0; ii < c_records; ++ii)
+		c.push_back(ii);
+	bench::report(name, c_records, bench::now() - start);
+	bench::do_not_optimize(c);
+}
+
+BENCHMARK(vm_vector_append_latency) {
+	vm_append<tinystl::vector<size_t> >("tinystl::vector");
+	vm_append<tinystl::vm_vector<size_t> >("tinystl::vm_vector");
+}
+
+BENCHMARK(vm_vector_append_throughput) {
+	vm_append_throughput<tinystl::vector<size_t> >("tinystl::vector");
+	vm_append_throughput<tinystl::vm_vector<size_t> >("tinystl::vm_vector");
+}
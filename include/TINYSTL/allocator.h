@@ -28,18 +28,243 @@
 #define TINYSTL_ALLOCATOR_H
 
 #include <TINYSTL/stddef.h>
+#include <stdlib.h>
+
+#if defined(_WIN32)
+#	include <malloc.h>
+#endif
+
+#if defined(__linux__)
+#	include <sys/mman.h>
+#endif
+
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+#	define TINYSTL_ALLOCATOR_MREMAP 1
+#else
+#	define TINYSTL_ALLOCATOR_MREMAP 0
+#endif
+
+#ifndef TINYSTL_ALLOCATOR_MMAP_THRESHOLD
+#	define TINYSTL_ALLOCATOR_MMAP_THRESHOLD (32 * 1024 * 1024)
+#endif
 
 namespace tinystl {
 
+	// Containers call static_allocate/static_deallocate through the
+	// allocator instance they hold. Stateless allocators implement them as
+	// static functions and cost nothing inside the container; stateful
+	// allocators (arenas, pools, per-thread heaps) implement them as member
+	// functions and are copied into the container at construction.
+	//
+	// An allocator may also provide
+	//   void* static_reallocate(void* ptr, size_t oldbytes, size_t newbytes)
+	// which resizes a block in place or moves its bytes to a new block. It
+	// returns 0 (leaving ptr untouched) when it cannot, and containers fall
+	// back to allocate/move/deallocate.
+	//
+	// An allocator that rounds requests up (size classes, pages) may provide
+	//   void* static_allocate_at_least(size_t bytes, size_t* actual)
+	// which stores the usable size of the returned block in *actual.
+	// Containers then use the whole block as capacity and later pass any
+	// size between bytes and *actual to static_deallocate/static_reallocate.
+	//
+	// Growth is up to the allocator too. If it provides
+	//   size_t static_grow(size_t oldbytes, size_t newbytes)
+	// containers that hold oldbytes and need room for newbytes reserve the
+	// returned number of bytes; otherwise they reserve newbytes * 3 / 2.
+	//
+	// Blocks are expected to be aligned to c_allocator_alignment. For
+	// over-aligned types containers call the overloads
+	//   void* static_allocate(size_t bytes, size_t alignment)
+	//   void static_deallocate(void* ptr, size_t bytes, size_t alignment)
+	// if the allocator has them, and otherwise over-allocate and align the
+	// block themselves.
+	static const size_t c_allocator_alignment = 2 * sizeof(void*);
+
 	struct allocator {
 		static void* static_allocate(size_t bytes) {
-			return operator new(bytes);
+#if TINYSTL_ALLOCATOR_MREMAP
+			if (bytes >= TINYSTL_ALLOCATOR_MMAP_THRESHOLD) {
+				void* ptr = mmap(0, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+				return (ptr == MAP_FAILED) ? 0 : ptr;
+			}
+#endif
+			return malloc(bytes);
 		}
 
-		static void static_deallocate(void* ptr, size_t /*bytes*/) {
-			operator delete(ptr);
+		static void static_deallocate(void* ptr, size_t bytes) {
+#if TINYSTL_ALLOCATOR_MREMAP
+			if (bytes >= TINYSTL_ALLOCATOR_MMAP_THRESHOLD) {
+				munmap(ptr, bytes);
+				return;
+			}
+#endif
+			(void)bytes;
+			free(ptr);
+		}
+
+		static void* static_reallocate(void* ptr, size_t oldbytes, size_t newbytes) {
+#if TINYSTL_ALLOCATOR_MREMAP
+			// very large blocks live in their own mapping; let the kernel move the pages
+			if (oldbytes >= TINYSTL_ALLOCATOR_MMAP_THRESHOLD && newbytes >= TINYSTL_ALLOCATOR_MMAP_THRESHOLD) {
+				void* newptr = mremap(ptr, oldbytes, newbytes, MREMAP_MAYMOVE);
+				return (newptr == MAP_FAILED) ? 0 : newptr;
+			}
+			if (oldbytes >= TINYSTL_ALLOCATOR_MMAP_THRESHOLD || newbytes >= TINYSTL_ALLOCATOR_MMAP_THRESHOLD)
+				return 0;
+#endif
+			(void)oldbytes;
+			return realloc(ptr, newbytes);
+		}
+
+		static void* static_allocate_at_least(size_t bytes, size_t* actual) {
+			// malloc hands out c_allocator_alignment granules anyway; mappings
+			// come in whole pages. Never round a malloc request over the mmap
+			// threshold or deallocation would pick the wrong path.
+			size_t rounded = (bytes + c_allocator_alignment - 1) & ~(c_allocator_alignment - 1);
+#if TINYSTL_ALLOCATOR_MREMAP
+			if (bytes >= TINYSTL_ALLOCATOR_MMAP_THRESHOLD)
+				rounded = (bytes + 4095) & ~(size_t)4095;
+			else if (rounded >= TINYSTL_ALLOCATOR_MMAP_THRESHOLD)
+				rounded = bytes;
+#endif
+			*actual = rounded;
+			return static_allocate(rounded);
+		}
+
+		static void* static_allocate(size_t bytes, size_t alignment) {
+#if TINYSTL_ALLOCATOR_MREMAP
+			if (bytes >= TINYSTL_ALLOCATOR_MMAP_THRESHOLD && alignment <= 4096)
+				return static_allocate(bytes);
+#endif
+#if defined(_WIN32)
+			return _aligned_malloc(bytes, alignment);
+#else
+			void* ptr = 0;
+			return posix_memalign(&ptr, alignment, bytes) ? 0 : ptr;
+#endif
+		}
+
+		static void static_deallocate(void* ptr, size_t bytes, size_t alignment) {
+#if TINYSTL_ALLOCATOR_MREMAP
+			if (bytes >= TINYSTL_ALLOCATOR_MMAP_THRESHOLD && alignment <= 4096) {
+				munmap(ptr, bytes);
+				return;
+			}
+#endif
+			(void)bytes, (void)alignment;
+#if defined(_WIN32)
+			_aligned_free(ptr);
+#else
+			free(ptr);
+#endif
 		}
 	};
+
+	template<typename Alloc>
+	static inline auto allocator_allocate_impl(Alloc& alloc, size_t bytes, size_t alignment, int)
+		-> decltype(alloc.static_allocate(bytes, alignment))
+	{
+		return alloc.static_allocate(bytes, alignment);
+	}
+
+	template<typename Alloc>
+	static inline void* allocator_allocate_impl(Alloc& alloc, size_t bytes, size_t alignment, ...) {
+		// stash the unaligned pointer just below the block we hand out
+		char* ptr = (char*)alloc.static_allocate(bytes + alignment);
+		if (!ptr)
+			return 0;
+
+		char* aligned = (char*)(((size_t)ptr + alignment) & ~(alignment - 1));
+		((void**)aligned)[-1] = ptr;
+		return aligned;
+	}
+
+	template<typename Alloc>
+	static inline auto allocator_deallocate_impl(Alloc& alloc, void* ptr, size_t bytes, size_t alignment, int)
+		-> decltype(alloc.static_deallocate(ptr, bytes, alignment))
+	{
+		alloc.static_deallocate(ptr, bytes, alignment);
+	}
+
+	template<typename Alloc>
+	static inline void allocator_deallocate_impl(Alloc& alloc, void* ptr, size_t bytes, size_t alignment, ...) {
+		if (ptr)
+			alloc.static_deallocate(((void**)ptr)[-1], bytes + alignment);
+	}
+
+	template<typename Alloc>
+	static inline void* allocator_allocate(Alloc& alloc, size_t bytes, size_t alignment) {
+		if (alignment <= c_allocator_alignment)
+			return alloc.static_allocate(bytes);
+		return allocator_allocate_impl(alloc, bytes, alignment, 0);
+	}
+
+	template<typename Alloc>
+	static inline void allocator_deallocate(Alloc& alloc, void* ptr, size_t bytes, size_t alignment) {
+		if (alignment <= c_allocator_alignment)
+			alloc.static_deallocate(ptr, bytes);
+		else
+			allocator_deallocate_impl(alloc, ptr, bytes, alignment, 0);
+	}
+
+	template<typename Alloc>
+	static inline auto allocator_reallocate_impl(Alloc& alloc, void* ptr, size_t oldbytes, size_t newbytes, int)
+		-> decltype(alloc.static_reallocate(ptr, oldbytes, newbytes))
+	{
+		return alloc.static_reallocate(ptr, oldbytes, newbytes);
+	}
+
+	template<typename Alloc>
+	static inline void* allocator_reallocate_impl(Alloc&, void*, size_t, size_t, ...) {
+		return 0;
+	}
+
+	template<typename Alloc>
+	static inline auto allocator_allocate_at_least_impl(Alloc& alloc, size_t bytes, size_t* actual, int)
+		-> decltype(alloc.static_allocate_at_least(bytes, actual))
+	{
+		return alloc.static_allocate_at_least(bytes, actual);
+	}
+
+	template<typename Alloc>
+	static inline void* allocator_allocate_at_least_impl(Alloc& alloc, size_t bytes, size_t*, ...) {
+		return alloc.static_allocate(bytes);
+	}
+
+	template<typename Alloc>
+	static inline void* allocator_allocate_at_least(Alloc& alloc, size_t bytes, size_t alignment, size_t* actual) {
+		*actual = bytes;
+		if (alignment > c_allocator_alignment)
+			return allocator_allocate(alloc, bytes, alignment);
+		return allocator_allocate_at_least_impl(alloc, bytes, actual, 0);
+	}
+
+	template<typename Alloc>
+	static inline auto allocator_grow_impl(Alloc& alloc, size_t oldbytes, size_t newbytes, int)
+		-> decltype(alloc.static_grow(oldbytes, newbytes))
+	{
+		return alloc.static_grow(oldbytes, newbytes);
+	}
+
+	template<typename Alloc>
+	static inline size_t allocator_grow_impl(Alloc&, size_t, size_t newbytes, ...) {
+		return (newbytes * 3) / 2;
+	}
+
+	template<typename Alloc>
+	static inline size_t allocator_grow(Alloc& alloc, size_t oldbytes, size_t newbytes) {
+		const size_t bytes = allocator_grow_impl(alloc, oldbytes, newbytes, 0);
+		return (bytes < newbytes) ? newbytes : bytes;
+	}
+
+	// realloc-style hooks only promise c_allocator_alignment
+	template<typename Alloc>
+	static inline void* allocator_reallocate(Alloc& alloc, void* ptr, size_t oldbytes, size_t newbytes, size_t alignment) {
+		if (alignment > c_allocator_alignment)
+			return 0;
+		return allocator_reallocate_impl(alloc, ptr, oldbytes, newbytes, 0);
+	}
 }
 
 #ifndef TINYSTL_ALLOCATOR
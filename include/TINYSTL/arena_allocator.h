@@ -0,0 +1,193 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TINYSTL_ARENA_ALLOCATOR_H
+#define TINYSTL_ARENA_ALLOCATOR_H
+
+#include <TINYSTL/allocator.h>
+#include <TINYSTL/stddef.h>
+
+namespace tinystl {
+
+	class arena {
+	public:
+		struct marker {
+			void* chunk;
+			char* current;
+		};
+
+		explicit arena(size_t chunksize = 64 * 1024);
+		~arena();
+
+		void* allocate(size_t bytes);
+		void* allocate(size_t bytes, size_t alignment);
+		void* reallocate(void* ptr, size_t oldbytes, size_t newbytes);
+
+		marker mark() const;
+		void rewind(marker m);
+		void reset();
+
+	private:
+		arena(const arena&);
+		arena& operator=(const arena&);
+
+		struct chunk {
+			chunk* next;
+			size_t size;
+		};
+
+		static const size_t c_alignment = c_allocator_alignment;
+		static const size_t c_header = (sizeof(chunk) + c_alignment - 1) & ~(c_alignment - 1);
+
+		chunk* m_chunks;
+		chunk* m_spare;
+		char* m_current;
+		char* m_end;
+		size_t m_chunksize;
+	};
+
+	struct arena_allocator {
+		typedef arena_allocator tinystl_relocatable;
+
+		explicit arena_allocator(arena* a);
+
+		void* static_allocate(size_t bytes);
+		void* static_allocate(size_t bytes, size_t alignment);
+		void* static_allocate_at_least(size_t bytes, size_t* actual);
+		void* static_reallocate(void* ptr, size_t oldbytes, size_t newbytes);
+		static void static_deallocate(void* /*ptr*/, size_t /*bytes*/) {}
+		static void static_deallocate(void* /*ptr*/, size_t /*bytes*/, size_t /*alignment*/) {}
+
+		arena* m_arena;
+	};
+
+	inline arena::arena(size_t chunksize)
+		: m_chunks(0)
+		, m_spare(0)
+		, m_current(0)
+		, m_end(0)
+		, m_chunksize(chunksize)
+	{
+	}
+
+	inline arena::~arena() {
+		rewind(marker());
+		while (m_spare) {
+			chunk* next = m_spare->next;
+			TINYSTL_ALLOCATOR::static_deallocate(m_spare, c_header + m_spare->size);
+			m_spare = next;
+		}
+	}
+
+	inline void* arena::allocate(size_t bytes) {
+		return allocate(bytes, c_alignment);
+	}
+
+	inline void* arena::allocate(size_t bytes, size_t alignment) {
+		bytes = (bytes + c_alignment - 1) & ~(c_alignment - 1);
+		char* ptr = (char*)(((size_t)m_current + alignment - 1) & ~(alignment - 1));
+		if (ptr > m_end || (size_t)(m_end - ptr) < bytes) {
+			const size_t needed = bytes + ((alignment > c_alignment) ? alignment - c_alignment : 0);
+
+			chunk* c = m_spare;
+			if (c && c->size >= needed) {
+				m_spare = c->next;
+			} else {
+				const size_t size = (needed > m_chunksize) ? needed : m_chunksize;
+				c = (chunk*)TINYSTL_ALLOCATOR::static_allocate(c_header + size);
+				c->size = size;
+			}
+
+			c->next = m_chunks;
+			m_chunks = c;
+			m_current = (char*)c + c_header;
+			m_end = m_current + c->size;
+			ptr = (char*)(((size_t)m_current + alignment - 1) & ~(alignment - 1));
+		}
+
+		m_current = ptr + bytes;
+		return ptr;
+	}
+
+	// Only the most recent allocation can grow, and only within its chunk
+	inline void* arena::reallocate(void* ptr, size_t oldbytes, size_t newbytes) {
+		oldbytes = (oldbytes + c_alignment - 1) & ~(c_alignment - 1);
+		newbytes = (newbytes + c_alignment - 1) & ~(c_alignment - 1);
+		if ((char*)ptr + oldbytes != m_current || (size_t)(m_end - (char*)ptr) < newbytes)
+			return 0;
+
+		m_current = (char*)ptr + newbytes;
+		return ptr;
+	}
+
+	inline arena::marker arena::mark() const {
+		marker m;
+		m.chunk = m_chunks;
+		m.current = m_current;
+		return m;
+	}
+
+	inline void arena::rewind(marker m) {
+		while (m_chunks != m.chunk) {
+			chunk* next = m_chunks->next;
+			m_chunks->next = m_spare;
+			m_spare = m_chunks;
+			m_chunks = next;
+		}
+
+		m_current = m.current;
+		m_end = m_chunks ? (char*)m_chunks + c_header + m_chunks->size : 0;
+	}
+
+	inline void arena::reset() {
+		rewind(marker());
+	}
+
+	inline arena_allocator::arena_allocator(arena* a)
+		: m_arena(a)
+	{
+	}
+
+	inline void* arena_allocator::static_allocate(size_t bytes) {
+		return m_arena->allocate(bytes);
+	}
+
+	inline void* arena_allocator::static_allocate(size_t bytes, size_t alignment) {
+		return m_arena->allocate(bytes, alignment);
+	}
+
+	inline void* arena_allocator::static_allocate_at_least(size_t bytes, size_t* actual) {
+		// the arena pads every block to its alignment anyway
+		*actual = (bytes + c_allocator_alignment - 1) & ~(c_allocator_alignment - 1);
+		return m_arena->allocate(*actual);
+	}
+
+	inline void* arena_allocator::static_reallocate(void* ptr, size_t oldbytes, size_t newbytes) {
+		return m_arena->reallocate(ptr, oldbytes, newbytes);
+	}
+}
+
+#endif
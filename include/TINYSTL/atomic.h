@@ -0,0 +1,182 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TINYSTL_ATOMIC_H
+#define TINYSTL_ATOMIC_H
+
+#include <TINYSTL/stddef.h>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#	include <intrin.h>
+#endif
+
+// Padding used to keep data written by different threads on separate lines
+#ifndef TINYSTL_CACHE_LINE_SIZE
+#	define TINYSTL_CACHE_LINE_SIZE 64
+#endif
+
+namespace tinystl {
+
+#if defined(__GNUC__) || defined(__clang__)
+	template<typename T>
+	static inline T atomic_load_relaxed(const T* ptr) {
+		return __atomic_load_n(ptr, __ATOMIC_RELAXED);
+	}
+
+	template<typename T>
+	static inline T atomic_load_acquire(const T* ptr) {
+		return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+	}
+
+	template<typename T>
+	static inline void atomic_store_relaxed(T* ptr, T value) {
+		__atomic_store_n(ptr, value, __ATOMIC_RELAXED);
+	}
+
+	template<typename T>
+	static inline void atomic_store_release(T* ptr, T value) {
+		__atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+	}
+
+	template<typename T>
+	static inline T atomic_exchange(T* ptr, T value) {
+		return __atomic_exchange_n(ptr, value, __ATOMIC_ACQ_REL);
+	}
+
+	template<typename T>
+	static inline T atomic_fetch_add(T* ptr, T value) {
+		return __atomic_fetch_add(ptr, value, __ATOMIC_ACQ_REL);
+	}
+
+	template<typename T>
+	static inline T atomic_fetch_add_relaxed(T* ptr, T value) {
+		return __atomic_fetch_add(ptr, value, __ATOMIC_RELAXED);
+	}
+
+	template<typename T>
+	static inline bool atomic_compare_exchange(T* ptr, T* expected, T desired) {
+		return __atomic_compare_exchange_n(ptr, expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+	}
+
+	static inline void atomic_pause() {
+#	if defined(__i386__) || defined(__x86_64__)
+		__builtin_ia32_pause();
+#	endif
+	}
+#elif defined(_MSC_VER)
+	template<size_t size> struct atomic_msvc;
+
+	template<> struct atomic_msvc<4> {
+		typedef long type;
+		static type exchange(volatile type* ptr, type value) { return _InterlockedExchange(ptr, value); }
+		static type fetch_add(volatile type* ptr, type value) { return _InterlockedExchangeAdd(ptr, value); }
+		static type compare_exchange(volatile type* ptr, type desired, type expected) { return _InterlockedCompareExchange(ptr, desired, expected); }
+	};
+
+	template<> struct atomic_msvc<8> {
+		typedef __int64 type;
+		static type exchange(volatile type* ptr, type value) { return _InterlockedExchange64(ptr, value); }
+		static type fetch_add(volatile type* ptr, type value) { return _InterlockedExchangeAdd64(ptr, value); }
+		static type compare_exchange(volatile type* ptr, type desired, type expected) { return _InterlockedCompareExchange64(ptr, desired, expected); }
+	};
+
+	// MSVC gives volatile accesses acquire/release semantics on x86 and x64
+	template<typename T>
+	static inline T atomic_load_relaxed(const T* ptr) {
+		return *(const volatile T*)ptr;
+	}
+
+	template<typename T>
+	static inline T atomic_load_acquire(const T* ptr) {
+		const T value = *(const volatile T*)ptr;
+		_ReadWriteBarrier();
+		return value;
+	}
+
+	template<typename T>
+	static inline void atomic_store_relaxed(T* ptr, T value) {
+		*(volatile T*)ptr = value;
+	}
+
+	template<typename T>
+	static inline void atomic_store_release(T* ptr, T value) {
+		_ReadWriteBarrier();
+		*(volatile T*)ptr = value;
+	}
+
+	template<typename T>
+	static inline T atomic_exchange(T* ptr, T value) {
+		typedef atomic_msvc<sizeof(T)> ops;
+		return (T)ops::exchange((volatile typename ops::type*)ptr, (typename ops::type)value);
+	}
+
+	template<typename T>
+	static inline T atomic_fetch_add(T* ptr, T value) {
+		typedef atomic_msvc<sizeof(T)> ops;
+		return (T)ops::fetch_add((volatile typename ops::type*)ptr, (typename ops::type)value);
+	}
+
+	template<typename T>
+	static inline T atomic_fetch_add_relaxed(T* ptr, T value) {
+		return atomic_fetch_add(ptr, value);
+	}
+
+	template<typename T>
+	static inline bool atomic_compare_exchange(T* ptr, T* expected, T desired) {
+		typedef atomic_msvc<sizeof(T)> ops;
+		const T previous = (T)ops::compare_exchange((volatile typename ops::type*)ptr, (typename ops::type)desired, (typename ops::type)*expected);
+		if (previous == *expected)
+			return true;
+		*expected = previous;
+		return false;
+	}
+
+	static inline void atomic_pause() {
+#	if defined(_M_IX86) || defined(_M_X64)
+		_mm_pause();
+#	endif
+	}
+#else
+#	error "tinystl: no atomic operations for this compiler"
+#endif
+
+	struct spinlock {
+		int locked;
+	};
+
+	static inline void spinlock_lock(spinlock* lock) {
+		while (atomic_exchange(&lock->locked, 1)) {
+			while (atomic_load_relaxed(&lock->locked))
+				atomic_pause();
+		}
+	}
+
+	static inline void spinlock_unlock(spinlock* lock) {
+		atomic_store_release(&lock->locked, 0);
+	}
+}
+
+#endif
@@ -30,11 +30,15 @@
 #include <TINYSTL/allocator.h>
 #include <TINYSTL/new.h>
 #include <TINYSTL/traits.h>
+#include <string.h>
 
 namespace tinystl {
 
 	template<typename T, typename Alloc = TINYSTL_ALLOCATOR>
-	struct buffer {
+	struct buffer : Alloc {
+		buffer() {}
+		explicit buffer(const Alloc& alloc) : Alloc(alloc) {}
+
 		T* first;
 		T* last;
 		T* capacity;
@@ -80,20 +84,42 @@ namespace tinystl {
 	}
 
 	template<typename T>
-	static inline void buffer_move_urange_traits(T* dest, T* first, T* last, pod_traits<T, false>) {
+	static inline void buffer_default_urange_traits(T* first, T* last, pod_traits<T, false>) {
+		for (; first < last; ++first)
+			new(placeholder(), first) T;
+	}
+
+	template<typename T>
+	static inline void buffer_default_urange_traits(T*, T*, pod_traits<T, true>) {
+	}
+
+	template<typename T>
+	static inline void buffer_copy_urange_traits(T* dest, const T* first, const T* last, pod_traits<T, false>) {
+		for (; first != last; ++first, ++dest)
+			new(placeholder(), dest) T(*first);
+	}
+
+	template<typename T>
+	static inline void buffer_copy_urange_traits(T* dest, const T* first, const T* last, pod_traits<T, true>) {
+		if (first != last)
+			memcpy((void*)dest, (const void*)first, (size_t)((const char*)last - (const char*)first));
+	}
+
+	template<typename T>
+	static inline void buffer_move_urange_traits(T* dest, T* first, T* last, relocatable_traits<T, false>) {
 		for (T* it = first; it != last; ++it, ++dest)
 			move_construct(dest, *it);
 		buffer_destroy_range(first, last);
 	}
 
 	template<typename T>
-	static inline void buffer_move_urange_traits(T* dest, T* first, T* last, pod_traits<T, true>) {
-		for (; first != last; ++first, ++dest)
-			*dest = *first;
+	static inline void buffer_move_urange_traits(T* dest, T* first, T* last, relocatable_traits<T, true>) {
+		if (first != last)
+			memcpy((void*)dest, (const void*)first, (size_t)((char*)last - (char*)first));
 	}
 
 	template<typename T>
-	static inline void buffer_bmove_urange_traits(T* dest, T* first, T* last, pod_traits<T, false>) {
+	static inline void buffer_bmove_urange_traits(T* dest, T* first, T* last, relocatable_traits<T, false>) {
 		dest += (last - first);
 		for (T* it = last; it != first; --it, --dest) {
 			move_construct(dest - 1, *(it - 1));
@@ -102,20 +128,19 @@ namespace tinystl {
 	}
 
 	template<typename T>
-	static inline void buffer_bmove_urange_traits(T* dest, T* first, T* last, pod_traits<T, true>) {
-		dest += (last - first);
-		for (T* it = last; it != first; --it, --dest)
-			*(dest - 1) = *(it - 1);
+	static inline void buffer_bmove_urange_traits(T* dest, T* first, T* last, relocatable_traits<T, true>) {
+		if (first != last)
+			memmove((void*)dest, (const void*)first, (size_t)((char*)last - (char*)first));
 	}
 
 	template<typename T>
 	static inline void buffer_move_urange(T* dest, T* first, T* last) {
-		buffer_move_urange_traits(dest, first, last, pod_traits<T>());
+		buffer_move_urange_traits(dest, first, last, relocatable_traits<T>());
 	}
 
 	template<typename T>
 	static inline void buffer_bmove_urange(T* dest, T* first, T* last) {
-		buffer_bmove_urange_traits(dest, first, last, pod_traits<T>());
+		buffer_bmove_urange_traits(dest, first, last, relocatable_traits<T>());
 	}
 
 	template<typename T>
@@ -128,36 +153,100 @@ namespace tinystl {
 		buffer_fill_urange_traits(first, last, value, pod_traits<T>());
 	}
 
+	// default-initializes: POD elements keep whatever bytes were there
+	template<typename T>
+	static inline void buffer_default_urange(T* first, T* last) {
+		buffer_default_urange_traits(first, last, pod_traits<T>());
+	}
+
+	template<typename T>
+	static inline void buffer_copy_urange(T* dest, const T* first, const T* last) {
+		buffer_copy_urange_traits(dest, first, last, pod_traits<T>());
+	}
+
 	template<typename T, typename Alloc>
 	static inline void buffer_init(buffer<T, Alloc>* b) {
 		b->first = b->last = b->capacity = 0;
 	}
 
+	template<typename T, typename Alloc>
+	static inline T* buffer_allocate(buffer<T, Alloc>* b, size_t capacity) {
+		return (T*)allocator_allocate(static_cast<Alloc&>(*b), sizeof(T) * capacity, alignof(T));
+	}
+
+	// Allocates room for at least capacity elements and raises capacity to
+	// whatever the allocator actually handed back.
+	template<typename T, typename Alloc>
+	static inline T* buffer_allocate_at_least(buffer<T, Alloc>* b, size_t* capacity) {
+		size_t bytes;
+		T* first = (T*)allocator_allocate_at_least(static_cast<Alloc&>(*b), sizeof(T) * *capacity, alignof(T), &bytes);
+		*capacity = bytes / sizeof(T);
+		return first;
+	}
+
+	template<typename T, typename Alloc>
+	static inline void buffer_deallocate(buffer<T, Alloc>* b) {
+		allocator_deallocate(static_cast<Alloc&>(*b), b->first, sizeof(T) * (size_t)(b->capacity - b->first), alignof(T));
+	}
+
 	template<typename T, typename Alloc>
 	static inline void buffer_destroy(buffer<T, Alloc>* b) {
 		buffer_destroy_range(b->first, b->last);
-		Alloc::static_deallocate(b->first, (size_t)((char*)b->capacity - (char*)b->first));
+		buffer_deallocate(b);
+	}
+
+	template<typename T, typename Alloc>
+	static inline T* buffer_reallocate_traits(buffer<T, Alloc>*, size_t, relocatable_traits<T, false>) {
+		return 0;
+	}
+
+	template<typename T, typename Alloc>
+	static inline T* buffer_reallocate_traits(buffer<T, Alloc>* b, size_t capacity, relocatable_traits<T, true>) {
+		const size_t oldbytes = sizeof(T) * (size_t)(b->capacity - b->first);
+		return (T*)allocator_reallocate(static_cast<Alloc&>(*b), b->first, oldbytes, sizeof(T) * capacity, alignof(T));
+	}
+
+	// Resizes the block through the allocator's reallocate hook when the
+	// elements can be moved bitwise. Returns 0 if the caller must copy.
+	template<typename T, typename Alloc>
+	static inline T* buffer_reallocate(buffer<T, Alloc>* b, size_t capacity) {
+		if (!b->first)
+			return 0;
+		return buffer_reallocate_traits(b, capacity, relocatable_traits<T>());
 	}
 
+	// Growth keeps any slack the allocator hands back; an exact reserve
+	// (from resize) asks for precisely the requested capacity.
 	template<typename T, typename Alloc>
-	static inline void buffer_reserve(buffer<T, Alloc>* b, size_t capacity) {
+	static inline void buffer_reserve(buffer<T, Alloc>* b, size_t capacity, bool exact = false) {
 		if (b->first && b->first + capacity <= b->capacity)
 			return;
 
 		typedef T* pointer;
 		const size_t size = (size_t)(b->last - b->first);
-		pointer newfirst = (pointer)Alloc::static_allocate(sizeof(T) * capacity);
-		buffer_move_urange(newfirst, b->first, b->last);
-		Alloc::static_deallocate(b->first, sizeof(T) * capacity);
+		pointer newfirst = buffer_reallocate(b, capacity);
+		if (!newfirst) {
+			newfirst = exact ? buffer_allocate(b, capacity) : buffer_allocate_at_least(b, &capacity);
+			buffer_move_urange(newfirst, b->first, b->last);
+			buffer_deallocate(b);
+		}
 
 		b->first = newfirst;
 		b->last = newfirst + size;
 		b->capacity = newfirst + capacity;
 	}
 
+	// Makes room for at least size elements using the allocator's growth policy
+	template<typename T, typename Alloc>
+	static inline void buffer_grow(buffer<T, Alloc>* b, size_t size) {
+		const size_t oldbytes = sizeof(T) * (size_t)(b->capacity - b->first);
+		const size_t capacity = allocator_grow(static_cast<Alloc&>(*b), oldbytes, sizeof(T) * size) / sizeof(T);
+		buffer_reserve(b, (capacity < size) ? size : capacity);
+	}
+
 	template<typename T, typename Alloc>
 	static inline void buffer_resize(buffer<T, Alloc>* b, size_t size) {
-		buffer_reserve(b, size);
+		buffer_reserve(b, size, true);
 
 		buffer_fill_urange(b->last, b->first + size);
 		buffer_destroy_range(b->first + size, b->last);
@@ -166,26 +255,36 @@ namespace tinystl {
 
 	template<typename T, typename Alloc>
 	static inline void buffer_resize(buffer<T, Alloc>* b, size_t size, const T& value) {
-		buffer_reserve(b, size);
+		buffer_reserve(b, size, true);
 
 		buffer_fill_urange(b->last, b->first + size, value);
 		buffer_destroy_range(b->first + size, b->last);
 		b->last = b->first + size;
 	}
 
+	template<typename T, typename Alloc>
+	static inline void buffer_resize_uninitialized(buffer<T, Alloc>* b, size_t size) {
+		buffer_reserve(b, size, true);
+
+		buffer_default_urange(b->last, b->first + size);
+		buffer_destroy_range(b->first + size, b->last);
+		b->last = b->first + size;
+	}
+
 	template<typename T, typename Alloc>
 	static inline void buffer_shrink_to_fit(buffer<T, Alloc>* b) {
 		if (b->capacity != b->last) {
 			if (b->last == b->first) {
-				const size_t capacity = (size_t)(b->capacity - b->first);
-				Alloc::static_deallocate(b->first, sizeof(T)*capacity);
+				buffer_deallocate(b);
 				b->capacity = b->first = b->last = nullptr;
 			} else {
-				const size_t capacity = (size_t)(b->capacity - b->first);
 				const size_t size = (size_t)(b->last - b->first);
-				T* newfirst = (T*)Alloc::static_allocate(sizeof(T) * size);
-				buffer_move_urange(newfirst, b->first, b->last);
-				Alloc::static_deallocate(b->first, sizeof(T) * capacity);
+				T* newfirst = buffer_reallocate(b, size);
+				if (!newfirst) {
+					newfirst = buffer_allocate(b, size);
+					buffer_move_urange(newfirst, b->first, b->last);
+					buffer_deallocate(b);
+				}
 				b->first = newfirst;
 				b->last = newfirst + size;
 				b->capacity = b->last;
@@ -204,7 +303,7 @@ namespace tinystl {
 		const size_t offset = (size_t)(where - b->first);
 		const size_t newsize = (size_t)((b->last - b->first) + count);
 		if (b->first + newsize > b->capacity)
-			buffer_reserve(b, (newsize * 3) / 2);
+			buffer_grow(b, newsize);
 
 		where = b->first + offset;
 
@@ -246,49 +345,79 @@ namespace tinystl {
 
 	template<typename T, typename Alloc, typename Param>
 	static inline void buffer_append(buffer<T, Alloc>* b, const Param* param) {
-		if (b->capacity != b->last) {
-			new(placeholder(), b->last) T(*param);
-			++b->last;
-		} else {
-			buffer_insert(b, b->last, param, param + 1);
+		if (b->capacity == b->last) {
+			typedef const char* pointer;
+			const bool frombuf = ((pointer)b->first <= (pointer)param && (pointer)b->last > (pointer)param);
+			const size_t offset = (size_t)((pointer)param - (pointer)b->first);
+			buffer_grow(b, (size_t)(b->last - b->first) + 1);
+			if (frombuf)
+				param = (const Param*)((pointer)b->first + offset);
 		}
+
+		new(placeholder(), b->last) T(*param);
+		++b->last;
 	}
 
-	template<typename T, typename Alloc>
-	static inline void buffer_append(buffer<T, Alloc>* b) {
-		if (b->capacity != b->last) {
-			new(placeholder(), b->last) T();
+	template<typename T, typename Alloc, typename... Args>
+	static inline void buffer_emplace(buffer<T, Alloc>* b, T* where, Args&&... args) {
+		if (where == b->last && b->last != b->capacity) {
+			new(placeholder(), b->last) T(static_cast<Args&&>(args)...);
 			++b->last;
-		} else {
-			buffer_insert(b, b->last, 1);
+			return;
 		}
+
+		// args may refer into the buffer, so build the element before anything moves
+		T value(static_cast<Args&&>(args)...);
+		where = buffer_insert_common(b, where, 1);
+		move_construct(where, value);
 	}
 
-	template<typename T, typename Alloc>
-	static inline T* buffer_erase(buffer<T, Alloc>* b, T* first, T* last) {
-		typedef T* pointer;
-		const size_t count = (last - first);
-		for (pointer it = last, end = b->last, dest = first; it != end; ++it, ++dest)
+	template<typename T>
+	static inline void buffer_erase_traits(T* first, T* last, T* end, relocatable_traits<T, false>) {
+		for (T* it = last, *dest = first; it != end; ++it, ++dest)
 			move(*dest, *it);
+		buffer_destroy_range(end - (last - first), end);
+	}
 
-		buffer_destroy_range(b->last - count, b->last);
+	template<typename T>
+	static inline void buffer_erase_traits(T* first, T* last, T* end, relocatable_traits<T, true>) {
+		buffer_destroy_range(first, last);
+		if (last != end)
+			memmove((void*)first, (const void*)last, (size_t)((char*)end - (char*)last));
+	}
 
-		b->last -= count;
+	template<typename T, typename Alloc>
+	static inline T* buffer_erase(buffer<T, Alloc>* b, T* first, T* last) {
+		buffer_erase_traits(first, last, b->last, relocatable_traits<T>());
+		b->last -= (last - first);
 		return first;
 	}
 
-	template<typename T, typename Alloc>
-	static inline T* buffer_erase_unordered(buffer<T, Alloc>* b, T* first, T* last) {
-		typedef T* pointer;
+	template<typename T>
+	static inline void buffer_erase_unordered_traits(T* first, T* last, T* end, relocatable_traits<T, false>) {
 		const size_t count = (last - first);
-		const size_t tail = (b->last - last);
-		pointer it = b->last - ((count < tail) ? count : tail);
-		for (pointer end = b->last, dest = first; it != end; ++it, ++dest)
+		const size_t tail = (end - last);
+		T* it = end - ((count < tail) ? count : tail);
+		for (T* dest = first; it != end; ++it, ++dest)
 			move(*dest, *it);
+		buffer_destroy_range(end - count, end);
+	}
 
-		buffer_destroy_range(b->last - count, b->last);
+	// the tail elements never overlap the hole they fill
+	template<typename T>
+	static inline void buffer_erase_unordered_traits(T* first, T* last, T* end, relocatable_traits<T, true>) {
+		const size_t count = (last - first);
+		const size_t tail = (end - last);
+		T* it = end - ((count < tail) ? count : tail);
+		buffer_destroy_range(first, last);
+		if (it != end)
+			memcpy((void*)first, (const void*)it, (size_t)((char*)end - (char*)it));
+	}
 
-		b->last -= count;
+	template<typename T, typename Alloc>
+	static inline T* buffer_erase_unordered(buffer<T, Alloc>* b, T* first, T* last) {
+		buffer_erase_unordered_traits(first, last, b->last, relocatable_traits<T>());
+		b->last -= (last - first);
 		return first;
 	}
 
@@ -298,10 +427,15 @@ namespace tinystl {
 		const pointer tfirst = b->first, tlast = b->last, tcapacity = b->capacity;
 		b->first = other->first, b->last = other->last, b->capacity = other->capacity;
 		other->first = tfirst, other->last = tlast, other->capacity = tcapacity;
+
+		const Alloc talloc = *b;
+		static_cast<Alloc&>(*b) = *other;
+		static_cast<Alloc&>(*other) = talloc;
 	}
 
 	template<typename T, typename Alloc>
 	static inline void buffer_move(buffer<T, Alloc>* dst, buffer<T, Alloc>* src) {
+		static_cast<Alloc&>(*dst) = *src;
 		dst->first = src->first, dst->last = src->last, dst->capacity = src->capacity;
 		src->first = src->last = src->capacity = nullptr;
 	}
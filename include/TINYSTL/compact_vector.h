@@ -0,0 +1,639 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TINYSTL_COMPACT_VECTOR_H
+#define TINYSTL_COMPACT_VECTOR_H
+
+#include <TINYSTL/allocator.h>
+#include <TINYSTL/buffer.h>
+#include <TINYSTL/new.h>
+#include <TINYSTL/stddef.h>
+#include <TINYSTL/traits.h>
+#include <stdlib.h>
+
+namespace tinystl {
+
+	// Storage for compact_vector: one pointer and two 32-bit counts, so the
+	// header is 16 bytes on 64-bit targets instead of buffer's 24.
+	template<typename T, typename Alloc = TINYSTL_ALLOCATOR>
+	struct compact_buffer : Alloc {
+		compact_buffer() {}
+		explicit compact_buffer(const Alloc& alloc) : Alloc(alloc) {}
+
+		T* first;
+		unsigned int size;
+		unsigned int capacity;
+	};
+
+	// Counts are 32 bits wide; asking for more elements aborts before any
+	// of them are constructed
+	static const size_t compact_buffer_max_size = 0xffffffffu;
+
+	template<typename T, typename Alloc>
+	static inline void compact_buffer_init(compact_buffer<T, Alloc>* b) {
+		b->first = 0;
+		b->size = b->capacity = 0;
+	}
+
+	template<typename T, typename Alloc>
+	static inline void compact_buffer_deallocate(compact_buffer<T, Alloc>* b) {
+		allocator_deallocate(static_cast<Alloc&>(*b), b->first, sizeof(T) * (size_t)b->capacity, alignof(T));
+	}
+
+	template<typename T, typename Alloc>
+	static inline void compact_buffer_destroy(compact_buffer<T, Alloc>* b) {
+		buffer_destroy_range(b->first, b->first + b->size);
+		compact_buffer_deallocate(b);
+	}
+
+	template<typename T, typename Alloc>
+	static inline T* compact_buffer_reallocate_traits(compact_buffer<T, Alloc>*, size_t, relocatable_traits<T, false>) {
+		return 0;
+	}
+
+	template<typename T, typename Alloc>
+	static inline T* compact_buffer_reallocate_traits(compact_buffer<T, Alloc>* b, size_t capacity, relocatable_traits<T, true>) {
+		return (T*)allocator_reallocate(static_cast<Alloc&>(*b), b->first, sizeof(T) * (size_t)b->capacity, sizeof(T) * capacity, alignof(T));
+	}
+
+	template<typename T, typename Alloc>
+	static inline void compact_buffer_reserve(compact_buffer<T, Alloc>* b, size_t capacity, bool exact = false) {
+		if (capacity <= b->capacity)
+			return;
+		if (capacity > compact_buffer_max_size)
+			abort();
+
+		T* newfirst = b->first ? compact_buffer_reallocate_traits(b, capacity, relocatable_traits<T>()) : 0;
+		if (!newfirst) {
+			if (exact) {
+				newfirst = (T*)allocator_allocate(static_cast<Alloc&>(*b), sizeof(T) * capacity, alignof(T));
+			} else {
+				size_t bytes;
+				newfirst = (T*)allocator_allocate_at_least(static_cast<Alloc&>(*b), sizeof(T) * capacity, alignof(T), &bytes);
+				capacity = bytes / sizeof(T);
+			}
+			buffer_move_urange(newfirst, b->first, b->first + b->size);
+			compact_buffer_deallocate(b);
+		}
+
+		// any slack beyond what the count can describe is simply not used;
+		// deallocation may report a size between the request and the slack
+		b->first = newfirst;
+		b->capacity = (unsigned int)((capacity < compact_buffer_max_size) ? capacity : compact_buffer_max_size);
+	}
+
+	template<typename T, typename Alloc>
+	static inline void compact_buffer_grow(compact_buffer<T, Alloc>* b, size_t size) {
+		size_t capacity = allocator_grow(static_cast<Alloc&>(*b), sizeof(T) * (size_t)b->capacity, sizeof(T) * size) / sizeof(T);
+		if (capacity > compact_buffer_max_size)
+			capacity = compact_buffer_max_size;
+		compact_buffer_reserve(b, (capacity < size) ? size : capacity);
+	}
+
+	template<typename T, typename Alloc>
+	static inline void compact_buffer_resize(compact_buffer<T, Alloc>* b, size_t size) {
+		compact_buffer_reserve(b, size, true);
+
+		buffer_fill_urange(b->first + b->size, b->first + size);
+		buffer_destroy_range(b->first + size, b->first + b->size);
+		b->size = (unsigned int)size;
+	}
+
+	template<typename T, typename Alloc>
+	static inline void compact_buffer_resize(compact_buffer<T, Alloc>* b, size_t size, const T& value) {
+		compact_buffer_reserve(b, size, true);
+
+		buffer_fill_urange(b->first + b->size, b->first + size, value);
+		buffer_destroy_range(b->first + size, b->first + b->size);
+		b->size = (unsigned int)size;
+	}
+
+	template<typename T, typename Alloc>
+	static inline void compact_buffer_resize_uninitialized(compact_buffer<T, Alloc>* b, size_t size) {
+		compact_buffer_reserve(b, size, true);
+
+		buffer_default_urange(b->first + b->size, b->first + size);
+		buffer_destroy_range(b->first + size, b->first + b->size);
+		b->size = (unsigned int)size;
+	}
+
+	template<typename T, typename Alloc>
+	static inline void compact_buffer_shrink_to_fit(compact_buffer<T, Alloc>* b) {
+		if (b->capacity == b->size)
+			return;
+
+		if (!b->size) {
+			compact_buffer_deallocate(b);
+			compact_buffer_init(b);
+			return;
+		}
+
+		T* newfirst = compact_buffer_reallocate_traits(b, b->size, relocatable_traits<T>());
+		if (!newfirst) {
+			newfirst = (T*)allocator_allocate(static_cast<Alloc&>(*b), sizeof(T) * (size_t)b->size, alignof(T));
+			buffer_move_urange(newfirst, b->first, b->first + b->size);
+			compact_buffer_deallocate(b);
+		}
+		b->first = newfirst;
+		b->capacity = b->size;
+	}
+
+	template<typename T, typename Alloc>
+	static inline void compact_buffer_clear(compact_buffer<T, Alloc>* b) {
+		buffer_destroy_range(b->first, b->first + b->size);
+		b->size = 0;
+	}
+
+	template<typename T, typename Alloc>
+	static inline T* compact_buffer_insert_common(compact_buffer<T, Alloc>* b, T* where, size_t count) {
+		const size_t offset = (size_t)(where - b->first);
+		const size_t newsize = (size_t)b->size + count;
+		if (newsize > b->capacity)
+			compact_buffer_grow(b, newsize);
+
+		where = b->first + offset;
+
+		T* last = b->first + b->size;
+		if (where != last)
+			buffer_bmove_urange(where + count, where, last);
+
+		b->size = (unsigned int)newsize;
+
+		return where;
+	}
+
+	template<typename T, typename Alloc>
+	static inline void compact_buffer_insert(compact_buffer<T, Alloc>* b, T* where, const T* first, const T* last) {
+		const size_t count = (size_t)(last - first);
+		const bool frombuf = (b->first <= first && b->first + b->size >= last);
+		if (frombuf) {
+			size_t offset = (size_t)(first - b->first);
+			if (where <= first)
+				offset += count;
+			where = compact_buffer_insert_common(b, where, count);
+			first = b->first + offset;
+			last = first + count;
+		} else {
+			where = compact_buffer_insert_common(b, where, count);
+		}
+		for (; first != last; ++first, ++where)
+			new(placeholder(), where) T(*first);
+	}
+
+	template<typename T, typename Alloc>
+	static inline void compact_buffer_insert(compact_buffer<T, Alloc>* b, T* where, size_t count) {
+		where = compact_buffer_insert_common(b, where, count);
+		for (T* end = where + count; where != end; ++where)
+			new(placeholder(), where) T();
+	}
+
+	template<typename T, typename Alloc>
+	static inline void compact_buffer_append(compact_buffer<T, Alloc>* b, const T* param) {
+		if (b->size == b->capacity) {
+			const bool frombuf = (b->first <= param && b->first + b->size > param);
+			const size_t offset = (size_t)(param - b->first);
+			compact_buffer_grow(b, (size_t)b->size + 1);
+			if (frombuf)
+				param = b->first + offset;
+		}
+
+		new(placeholder(), b->first + b->size) T(*param);
+		++b->size;
+	}
+
+	template<typename T, typename Alloc, typename... Args>
+	static inline void compact_buffer_emplace(compact_buffer<T, Alloc>* b, T* where, Args&&... args) {
+		if (where == b->first + b->size && b->size != b->capacity) {
+			new(placeholder(), where) T(static_cast<Args&&>(args)...);
+			++b->size;
+			return;
+		}
+
+		T value(static_cast<Args&&>(args)...);
+		where = compact_buffer_insert_common(b, where, 1);
+		move_construct(where, value);
+	}
+
+	template<typename T, typename Alloc>
+	static inline T* compact_buffer_erase(compact_buffer<T, Alloc>* b, T* first, T* last) {
+		buffer_erase_traits(first, last, b->first + b->size, relocatable_traits<T>());
+		b->size -= (unsigned int)(last - first);
+		return first;
+	}
+
+	template<typename T, typename Alloc>
+	static inline T* compact_buffer_erase_unordered(compact_buffer<T, Alloc>* b, T* first, T* last) {
+		buffer_erase_unordered_traits(first, last, b->first + b->size, relocatable_traits<T>());
+		b->size -= (unsigned int)(last - first);
+		return first;
+	}
+
+	template<typename T, typename Alloc>
+	static inline void compact_buffer_swap(compact_buffer<T, Alloc>* b, compact_buffer<T, Alloc>* other) {
+		T* const tfirst = b->first;
+		const unsigned int tsize = b->size, tcapacity = b->capacity;
+		b->first = other->first, b->size = other->size, b->capacity = other->capacity;
+		other->first = tfirst, other->size = tsize, other->capacity = tcapacity;
+
+		const Alloc talloc = *b;
+		static_cast<Alloc&>(*b) = *other;
+		static_cast<Alloc&>(*other) = talloc;
+	}
+
+	template<typename T, typename Alloc>
+	static inline void compact_buffer_move(compact_buffer<T, Alloc>* dst, compact_buffer<T, Alloc>* src) {
+		static_cast<Alloc&>(*dst) = *src;
+		dst->first = src->first, dst->size = src->size, dst->capacity = src->capacity;
+		compact_buffer_init(src);
+	}
+
+	// A vector limited to 2^32-1 elements whose header is a pointer and two
+	// 32-bit counts. Meant for large numbers of short vectors embedded in
+	// other structures.
+	template<typename T, typename Alloc = TINYSTL_ALLOCATOR>
+	class compact_vector {
+	public:
+		compact_vector();
+		explicit compact_vector(const Alloc& alloc);
+		compact_vector(const compact_vector& other);
+		compact_vector(compact_vector&& other);
+		compact_vector(size_t size);
+		compact_vector(size_t size, const T& value);
+		compact_vector(const T* first, const T* last);
+		compact_vector(size_t size, const Alloc& alloc);
+		compact_vector(size_t size, const T& value, const Alloc& alloc);
+		compact_vector(const T* first, const T* last, const Alloc& alloc);
+		~compact_vector();
+
+		compact_vector& operator=(const compact_vector& other);
+		compact_vector& operator=(compact_vector&& other);
+
+		void assign(const T* first, const T* last);
+
+		const Alloc& get_allocator() const;
+
+		const T* data() const;
+		T* data();
+		size_t size() const;
+		size_t capacity() const;
+		bool empty() const;
+
+		T& operator[](size_t idx);
+		const T& operator[](size_t idx) const;
+
+		const T& front() const;
+		T& front();
+		const T& back() const;
+		T& back();
+
+		void resize(size_t size);
+		void resize(size_t size, const T& value);
+		void resize_uninitialized(size_t size);
+		void clear();
+		void reserve(size_t capacity);
+
+		void push_back(const T& t);
+		void push_back(T&& t);
+		void pop_back();
+
+		template<typename... Args>
+		void emplace_back(Args&&... args);
+
+		void shrink_to_fit();
+
+		void swap(compact_vector& other);
+
+		typedef T value_type;
+
+		typedef T* iterator;
+		iterator begin();
+		iterator end();
+
+		typedef const T* const_iterator;
+		const_iterator begin() const;
+		const_iterator end() const;
+
+		void insert(iterator where);
+		void insert(iterator where, const T& value);
+		void insert(iterator where, T&& value);
+		void insert(iterator where, const T* first, const T* last);
+
+		template<typename... Args>
+		void emplace(iterator where, Args&&... args);
+
+		iterator erase(iterator where);
+		iterator erase(iterator first, iterator last);
+
+		iterator erase_unordered(iterator where);
+		iterator erase_unordered(iterator first, iterator last);
+
+	private:
+		compact_buffer<T, Alloc> m_buffer;
+	};
+
+	template<typename T, typename Alloc>
+	struct is_trivially_relocatable<compact_vector<T, Alloc> > {
+		static const bool value = is_trivially_relocatable<Alloc>::value;
+	};
+
+	template<typename T, typename Alloc>
+	inline compact_vector<T, Alloc>::compact_vector() {
+		compact_buffer_init(&m_buffer);
+	}
+
+	template<typename T, typename Alloc>
+	inline compact_vector<T, Alloc>::compact_vector(const Alloc& alloc)
+		: m_buffer(alloc)
+	{
+		compact_buffer_init(&m_buffer);
+	}
+
+	template<typename T, typename Alloc>
+	inline compact_vector<T, Alloc>::compact_vector(const compact_vector& other)
+		: m_buffer(other.get_allocator())
+	{
+		compact_buffer_init(&m_buffer);
+		compact_buffer_reserve(&m_buffer, other.size(), true);
+		compact_buffer_insert(&m_buffer, end(), other.begin(), other.end());
+	}
+
+	template<typename T, typename Alloc>
+	inline compact_vector<T, Alloc>::compact_vector(compact_vector&& other)
+		: m_buffer(other.get_allocator())
+	{
+		compact_buffer_move(&m_buffer, &other.m_buffer);
+	}
+
+	template<typename T, typename Alloc>
+	inline compact_vector<T, Alloc>::compact_vector(size_t size) {
+		compact_buffer_init(&m_buffer);
+		compact_buffer_resize(&m_buffer, size);
+	}
+
+	template<typename T, typename Alloc>
+	inline compact_vector<T, Alloc>::compact_vector(size_t size, const T& value) {
+		compact_buffer_init(&m_buffer);
+		compact_buffer_resize(&m_buffer, size, value);
+	}
+
+	template<typename T, typename Alloc>
+	inline compact_vector<T, Alloc>::compact_vector(const T* first, const T* last) {
+		compact_buffer_init(&m_buffer);
+		compact_buffer_insert(&m_buffer, end(), first, last);
+	}
+
+	template<typename T, typename Alloc>
+	inline compact_vector<T, Alloc>::compact_vector(size_t size, const Alloc& alloc)
+		: m_buffer(alloc)
+	{
+		compact_buffer_init(&m_buffer);
+		compact_buffer_resize(&m_buffer, size);
+	}
+
+	template<typename T, typename Alloc>
+	inline compact_vector<T, Alloc>::compact_vector(size_t size, const T& value, const Alloc& alloc)
+		: m_buffer(alloc)
+	{
+		compact_buffer_init(&m_buffer);
+		compact_buffer_resize(&m_buffer, size, value);
+	}
+
+	template<typename T, typename Alloc>
+	inline compact_vector<T, Alloc>::compact_vector(const T* first, const T* last, const Alloc& alloc)
+		: m_buffer(alloc)
+	{
+		compact_buffer_init(&m_buffer);
+		compact_buffer_insert(&m_buffer, end(), first, last);
+	}
+
+	template<typename T, typename Alloc>
+	inline compact_vector<T, Alloc>::~compact_vector() {
+		compact_buffer_destroy(&m_buffer);
+	}
+
+	template<typename T, typename Alloc>
+	inline compact_vector<T, Alloc>& compact_vector<T, Alloc>::operator=(const compact_vector& other) {
+		compact_vector(other).swap(*this);
+		return *this;
+	}
+
+	template<typename T, typename Alloc>
+	inline compact_vector<T, Alloc>& compact_vector<T, Alloc>::operator=(compact_vector&& other) {
+		compact_buffer_destroy(&m_buffer);
+		compact_buffer_move(&m_buffer, &other.m_buffer);
+		return *this;
+	}
+
+	template<typename T, typename Alloc>
+	inline void compact_vector<T, Alloc>::assign(const T* first, const T* last) {
+		compact_buffer_clear(&m_buffer);
+		compact_buffer_insert(&m_buffer, end(), first, last);
+	}
+
+	template<typename T, typename Alloc>
+	inline const Alloc& compact_vector<T, Alloc>::get_allocator() const {
+		return m_buffer;
+	}
+
+	template<typename T, typename Alloc>
+	inline const T* compact_vector<T, Alloc>::data() const {
+		return m_buffer.first;
+	}
+
+	template<typename T, typename Alloc>
+	inline T* compact_vector<T, Alloc>::data() {
+		return m_buffer.first;
+	}
+
+	template<typename T, typename Alloc>
+	inline size_t compact_vector<T, Alloc>::size() const {
+		return m_buffer.size;
+	}
+
+	template<typename T, typename Alloc>
+	inline size_t compact_vector<T, Alloc>::capacity() const {
+		return m_buffer.capacity;
+	}
+
+	template<typename T, typename Alloc>
+	inline bool compact_vector<T, Alloc>::empty() const {
+		return m_buffer.size == 0;
+	}
+
+	template<typename T, typename Alloc>
+	inline T& compact_vector<T, Alloc>::operator[](size_t idx) {
+		return m_buffer.first[idx];
+	}
+
+	template<typename T, typename Alloc>
+	inline const T& compact_vector<T, Alloc>::operator[](size_t idx) const {
+		return m_buffer.first[idx];
+	}
+
+	template<typename T, typename Alloc>
+	inline const T& compact_vector<T, Alloc>::front() const {
+		return m_buffer.first[0];
+	}
+
+	template<typename T, typename Alloc>
+	inline T& compact_vector<T, Alloc>::front() {
+		return m_buffer.first[0];
+	}
+
+	template<typename T, typename Alloc>
+	inline const T& compact_vector<T, Alloc>::back() const {
+		return m_buffer.first[m_buffer.size - 1];
+	}
+
+	template<typename T, typename Alloc>
+	inline T& compact_vector<T, Alloc>::back() {
+		return m_buffer.first[m_buffer.size - 1];
+	}
+
+	template<typename T, typename Alloc>
+	inline void compact_vector<T, Alloc>::resize(size_t size) {
+		compact_buffer_resize(&m_buffer, size);
+	}
+
+	template<typename T, typename Alloc>
+	inline void compact_vector<T, Alloc>::resize(size_t size, const T& value) {
+		compact_buffer_resize(&m_buffer, size, value);
+	}
+
+	template<typename T, typename Alloc>
+	inline void compact_vector<T, Alloc>::resize_uninitialized(size_t size) {
+		compact_buffer_resize_uninitialized(&m_buffer, size);
+	}
+
+	template<typename T, typename Alloc>
+	inline void compact_vector<T, Alloc>::clear() {
+		compact_buffer_clear(&m_buffer);
+	}
+
+	template<typename T, typename Alloc>
+	inline void compact_vector<T, Alloc>::reserve(size_t capacity) {
+		compact_buffer_reserve(&m_buffer, capacity);
+	}
+
+	template<typename T, typename Alloc>
+	inline void compact_vector<T, Alloc>::push_back(const T& t) {
+		compact_buffer_append(&m_buffer, &t);
+	}
+
+	template<typename T, typename Alloc>
+	inline void compact_vector<T, Alloc>::push_back(T&& t) {
+		compact_buffer_emplace(&m_buffer, end(), static_cast<T&&>(t));
+	}
+
+	template<typename T, typename Alloc>
+	template<typename... Args>
+	inline void compact_vector<T, Alloc>::emplace_back(Args&&... args) {
+		compact_buffer_emplace(&m_buffer, end(), static_cast<Args&&>(args)...);
+	}
+
+	template<typename T, typename Alloc>
+	inline void compact_vector<T, Alloc>::pop_back() {
+		compact_buffer_erase(&m_buffer, end() - 1, end());
+	}
+
+	template<typename T, typename Alloc>
+	inline void compact_vector<T, Alloc>::shrink_to_fit() {
+		compact_buffer_shrink_to_fit(&m_buffer);
+	}
+
+	template<typename T, typename Alloc>
+	inline void compact_vector<T, Alloc>::swap(compact_vector& other) {
+		compact_buffer_swap(&m_buffer, &other.m_buffer);
+	}
+
+	template<typename T, typename Alloc>
+	inline typename compact_vector<T, Alloc>::iterator compact_vector<T, Alloc>::begin() {
+		return m_buffer.first;
+	}
+
+	template<typename T, typename Alloc>
+	inline typename compact_vector<T, Alloc>::iterator compact_vector<T, Alloc>::end() {
+		return m_buffer.first + m_buffer.size;
+	}
+
+	template<typename T, typename Alloc>
+	inline typename compact_vector<T, Alloc>::const_iterator compact_vector<T, Alloc>::begin() const {
+		return m_buffer.first;
+	}
+
+	template<typename T, typename Alloc>
+	inline typename compact_vector<T, Alloc>::const_iterator compact_vector<T, Alloc>::end() const {
+		return m_buffer.first + m_buffer.size;
+	}
+
+	template<typename T, typename Alloc>
+	inline void compact_vector<T, Alloc>::insert(iterator where) {
+		compact_buffer_insert(&m_buffer, where, 1);
+	}
+
+	template<typename T, typename Alloc>
+	inline void compact_vector<T, Alloc>::insert(iterator where, const T& value) {
+		compact_buffer_insert(&m_buffer, where, &value, &value + 1);
+	}
+
+	template<typename T, typename Alloc>
+	inline void compact_vector<T, Alloc>::insert(iterator where, T&& value) {
+		compact_buffer_emplace(&m_buffer, where, static_cast<T&&>(value));
+	}
+
+	template<typename T, typename Alloc>
+	inline void compact_vector<T, Alloc>::insert(iterator where, const T* first, const T* last) {
+		compact_buffer_insert(&m_buffer, where, first, last);
+	}
+
+	template<typename T, typename Alloc>
+	template<typename... Args>
+	inline void compact_vector<T, Alloc>::emplace(iterator where, Args&&... args) {
+		compact_buffer_emplace(&m_buffer, where, static_cast<Args&&>(args)...);
+	}
+
+	template<typename T, typename Alloc>
+	inline typename compact_vector<T, Alloc>::iterator compact_vector<T, Alloc>::erase(iterator where) {
+		return compact_buffer_erase(&m_buffer, where, where + 1);
+	}
+
+	template<typename T, typename Alloc>
+	inline typename compact_vector<T, Alloc>::iterator compact_vector<T, Alloc>::erase(iterator first, iterator last) {
+		return compact_buffer_erase(&m_buffer, first, last);
+	}
+
+	template<typename T, typename Alloc>
+	inline typename compact_vector<T, Alloc>::iterator compact_vector<T, Alloc>::erase_unordered(iterator where) {
+		return compact_buffer_erase_unordered(&m_buffer, where, where + 1);
+	}
+
+	template<typename T, typename Alloc>
+	inline typename compact_vector<T, Alloc>::iterator compact_vector<T, Alloc>::erase_unordered(iterator first, iterator last) {
+		return compact_buffer_erase_unordered(&m_buffer, first, last);
+	}
+}
+
+#endif
@@ -0,0 +1,622 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TINYSTL_CUCKOO_SET_H
+#define TINYSTL_CUCKOO_SET_H
+
+#include <TINYSTL/allocator.h>
+#include <TINYSTL/atomic.h>
+#include <TINYSTL/buffer.h>
+#include <TINYSTL/hash.h>
+#include <TINYSTL/hash_base.h>
+#include <TINYSTL/new.h>
+#include <TINYSTL/stddef.h>
+#include <TINYSTL/traits.h>
+
+namespace tinystl {
+
+	static const size_t c_cuckoo_set_slots = 4;
+
+	// Bounds on the displacement search made by an insert: the longest chain
+	// of moves, and the number of buckets visited
+	static const size_t c_cuckoo_set_depth = 5;
+	static const size_t c_cuckoo_set_search = 256;
+
+	// Every key lives in one of two buckets of four slots, so a lookup reads
+	// at most two buckets. A bucket is aligned to the next power of two of
+	// its size, up to a cache line, so that small keys never straddle lines.
+	template<typename Key>
+	struct cuckoo_set_layout {
+		struct unaligned {
+			unsigned char tags[c_cuckoo_set_slots];
+			alignas(Key) char keys[c_cuckoo_set_slots * sizeof(Key)];
+		};
+
+		static const size_t fit = (sizeof(unaligned) <= 16) ? 16 : (sizeof(unaligned) <= 32) ? 32 : TINYSTL_CACHE_LINE_SIZE;
+		static const size_t alignment = (fit < alignof(Key)) ? alignof(Key) : fit;
+	};
+
+	// A zero tag marks a free slot; otherwise it holds 8 bits of the key's
+	// hash, checked before the key itself is compared
+	template<typename Key>
+	struct alignas(cuckoo_set_layout<Key>::alignment) cuckoo_set_bucket {
+		Key* key(size_t slot) { return (Key*)keys + slot; }
+		const Key* key(size_t slot) const { return (const Key*)keys + slot; }
+
+		unsigned char tags[c_cuckoo_set_slots];
+		alignas(Key) char keys[c_cuckoo_set_slots * sizeof(Key)];
+	};
+
+	struct cuckoo_set_location {
+		size_t first;
+		size_t second;
+		unsigned char tag;
+	};
+
+	static inline unsigned long long cuckoo_set_mix(unsigned long long x) {
+		x ^= x >> 33;
+		x *= 0xff51afd7ed558ccdull;
+		x ^= x >> 33;
+		x *= 0xc4ceb9fe1a85ec53ull;
+		x ^= x >> 33;
+		return x;
+	}
+
+	// Derives both bucket choices and the tag from one hash of the key; the
+	// seed changes all three when a table has to be rebuilt
+	static inline cuckoo_set_location cuckoo_set_locate(size_t keyhash, size_t seed, size_t mask) {
+		const unsigned long long h1 = cuckoo_set_mix((unsigned long long)keyhash + seed);
+		const unsigned long long h2 = cuckoo_set_mix(h1);
+
+		cuckoo_set_location location;
+		location.first = (size_t)h1 & mask;
+		location.second = (size_t)h2 & mask;
+		if (location.second == location.first)
+			location.second = location.first ^ 1;
+		location.tag = (unsigned char)(h1 >> 56);
+		if (!location.tag)
+			location.tag = 1;
+		return location;
+	}
+
+	template<typename Key>
+	struct cuckoo_set_iterator {
+		const Key* operator->() const;
+		const Key& operator*() const;
+
+		const cuckoo_set_bucket<Key>* bucket;
+		size_t slot;
+	};
+
+	template<typename Key>
+	static inline bool operator==(const cuckoo_set_iterator<Key>& lhs, const cuckoo_set_iterator<Key>& rhs) {
+		return lhs.bucket == rhs.bucket && lhs.slot == rhs.slot;
+	}
+
+	template<typename Key>
+	static inline bool operator!=(const cuckoo_set_iterator<Key>& lhs, const cuckoo_set_iterator<Key>& rhs) {
+		return lhs.bucket != rhs.bucket || lhs.slot != rhs.slot;
+	}
+
+	// skips free slots; the bucket past the last one has a nonzero first tag
+	template<typename Key>
+	static inline void operator++(cuckoo_set_iterator<Key>& lhs) {
+		do {
+			if (++lhs.slot == c_cuckoo_set_slots) {
+				lhs.slot = 0;
+				++lhs.bucket;
+			}
+		} while (!lhs.bucket->tags[lhs.slot]);
+	}
+
+	template<typename Key>
+	inline const Key* cuckoo_set_iterator<Key>::operator->() const {
+		return bucket->key(slot);
+	}
+
+	template<typename Key>
+	inline const Key& cuckoo_set_iterator<Key>::operator*() const {
+		return *bucket->key(slot);
+	}
+
+	template<typename Key, typename Alloc>
+	struct cuckoo_set_table : Alloc {
+		typedef cuckoo_set_bucket<Key> bucket;
+
+		cuckoo_set_table() {}
+		explicit cuckoo_set_table(const Alloc& alloc) : Alloc(alloc) {}
+
+		bucket* buckets;
+		size_t nbuckets;
+		size_t size;
+		size_t seed;
+	};
+
+	template<typename Key, typename Alloc>
+	static inline void cuckoo_set_init(cuckoo_set_table<Key, Alloc>* t) {
+		t->buckets = 0;
+		t->nbuckets = t->size = t->seed = 0;
+	}
+
+	// The bucket past the last one is all tags, so iteration stops there
+	template<typename Key, typename Alloc>
+	static inline void cuckoo_set_allocate(cuckoo_set_table<Key, Alloc>* t, size_t nbuckets) {
+		typedef typename cuckoo_set_table<Key, Alloc>::bucket bucket;
+
+		t->buckets = (bucket*)allocator_allocate(static_cast<Alloc&>(*t), sizeof(bucket) * (nbuckets + 1), alignof(bucket));
+		t->nbuckets = nbuckets;
+		for (size_t bb = 0; bb != nbuckets + 1; ++bb) {
+			for (size_t ss = 0; ss != c_cuckoo_set_slots; ++ss)
+				t->buckets[bb].tags[ss] = (bb == nbuckets);
+		}
+	}
+
+	template<typename Key, typename Alloc>
+	static inline void cuckoo_set_deallocate(cuckoo_set_table<Key, Alloc>* t) {
+		typedef typename cuckoo_set_table<Key, Alloc>::bucket bucket;
+
+		if (t->buckets)
+			allocator_deallocate(static_cast<Alloc&>(*t), t->buckets, sizeof(bucket) * (t->nbuckets + 1), alignof(bucket));
+	}
+
+	template<typename Key, typename Alloc>
+	static inline void cuckoo_set_destroy_keys(cuckoo_set_table<Key, Alloc>* t) {
+		for (size_t bb = 0; bb != t->nbuckets; ++bb) {
+			for (size_t ss = 0; ss != c_cuckoo_set_slots; ++ss) {
+				if (t->buckets[bb].tags[ss])
+					t->buckets[bb].key(ss)->~Key();
+			}
+		}
+	}
+
+	template<typename Key, typename Alloc>
+	static inline void cuckoo_set_clear(cuckoo_set_table<Key, Alloc>* t) {
+		cuckoo_set_destroy_keys(t);
+		for (size_t bb = 0; bb != t->nbuckets; ++bb) {
+			for (size_t ss = 0; ss != c_cuckoo_set_slots; ++ss)
+				t->buckets[bb].tags[ss] = 0;
+		}
+		t->size = 0;
+	}
+
+	template<typename Key, typename Alloc>
+	static inline cuckoo_set_iterator<Key> cuckoo_set_make_iterator(const cuckoo_set_table<Key, Alloc>* t, size_t bucket, size_t slot) {
+		cuckoo_set_iterator<Key> it;
+		it.bucket = t->buckets + bucket;
+		it.slot = slot;
+		return it;
+	}
+
+	template<typename Key, typename Alloc>
+	static inline cuckoo_set_iterator<Key> cuckoo_set_begin(const cuckoo_set_table<Key, Alloc>* t) {
+		cuckoo_set_iterator<Key> it = cuckoo_set_make_iterator(t, 0, 0);
+		if (t->nbuckets && !it.bucket->tags[0])
+			++it;
+		return it;
+	}
+
+	template<typename Key, typename Alloc>
+	static inline cuckoo_set_iterator<Key> cuckoo_set_end(const cuckoo_set_table<Key, Alloc>* t) {
+		return cuckoo_set_make_iterator(t, t->nbuckets, 0);
+	}
+
+	// Returns the slot holding key, or the end iterator if it is not present
+	template<typename Key, typename Alloc>
+	static inline cuckoo_set_iterator<Key> cuckoo_set_find(const cuckoo_set_table<Key, Alloc>* t, const Key& key, size_t keyhash) {
+		if (!t->size)
+			return cuckoo_set_end(t);
+
+		const cuckoo_set_location location = cuckoo_set_locate(keyhash, t->seed, t->nbuckets - 1);
+
+		const cuckoo_set_bucket<Key>* first = t->buckets + location.first;
+		for (size_t ss = 0; ss != c_cuckoo_set_slots; ++ss) {
+			if (first->tags[ss] == location.tag && *first->key(ss) == key)
+				return cuckoo_set_make_iterator(t, location.first, ss);
+		}
+
+		const cuckoo_set_bucket<Key>* second = t->buckets + location.second;
+		for (size_t ss = 0; ss != c_cuckoo_set_slots; ++ss) {
+			if (second->tags[ss] == location.tag && *second->key(ss) == key)
+				return cuckoo_set_make_iterator(t, location.second, ss);
+		}
+
+		return cuckoo_set_end(t);
+	}
+
+	// Breadth-first search from both buckets for a bucket with a free slot,
+	// then shifts each key along the path into the next bucket, starting at
+	// the free end, so the free slot ends up in one of the new key's buckets
+	template<typename Key, typename Alloc>
+	static inline bool cuckoo_set_path(cuckoo_set_table<Key, Alloc>* t, const cuckoo_set_location& location, cuckoo_set_iterator<Key>* result) {
+		typedef typename cuckoo_set_table<Key, Alloc>::bucket bucket;
+
+		struct node {
+			size_t bucket;
+			size_t parent;
+			size_t slot;
+			size_t depth;
+		};
+
+		static const size_t c_root = (size_t)-1;
+
+		node queue[c_cuckoo_set_search];
+		queue[0].bucket = location.first;
+		queue[1].bucket = location.second;
+		queue[0].parent = queue[1].parent = c_root;
+		queue[0].slot = queue[1].slot = 0;
+		queue[0].depth = queue[1].depth = 0;
+
+		const size_t mask = t->nbuckets - 1;
+		for (size_t head = 0, tail = 2; head != tail; ++head) {
+			bucket* b = t->buckets + queue[head].bucket;
+
+			size_t free = 0;
+			while (free != c_cuckoo_set_slots && b->tags[free])
+				++free;
+
+			if (free != c_cuckoo_set_slots) {
+				size_t at = head;
+				while (queue[at].parent != c_root) {
+					const node& from = queue[queue[at].parent];
+					bucket* src = t->buckets + from.bucket;
+					bucket* dst = t->buckets + queue[at].bucket;
+
+					buffer_move_urange(dst->key(free), src->key(queue[at].slot), src->key(queue[at].slot) + 1);
+					dst->tags[free] = src->tags[queue[at].slot];
+					src->tags[queue[at].slot] = 0;
+
+					free = queue[at].slot;
+					at = queue[at].parent;
+				}
+
+				*result = cuckoo_set_make_iterator(t, queue[at].bucket, free);
+				return true;
+			}
+
+			if (queue[head].depth == c_cuckoo_set_depth)
+				continue;
+
+			for (size_t ss = 0; ss != c_cuckoo_set_slots && tail != c_cuckoo_set_search; ++ss) {
+				const cuckoo_set_location other = cuckoo_set_locate(hash(*b->key(ss)), t->seed, mask);
+				const size_t alternate = (other.first == queue[head].bucket) ? other.second : other.first;
+
+				// a bucket may appear only once along a path, so every
+				// move along it touches a different slot
+				bool cycle = false;
+				for (size_t at = head; at != c_root && !cycle; at = queue[at].parent)
+					cycle = (queue[at].bucket == alternate);
+				if (cycle)
+					continue;
+
+				queue[tail].bucket = alternate;
+				queue[tail].parent = head;
+				queue[tail].slot = ss;
+				queue[tail].depth = queue[head].depth + 1;
+				++tail;
+			}
+		}
+
+		return false;
+	}
+
+	template<typename Key, typename Alloc>
+	static inline void cuckoo_set_rehash(cuckoo_set_table<Key, Alloc>* t, size_t nbuckets, size_t seed);
+
+	// Claims a free slot for a key known to be absent and sets its tag; the
+	// caller constructs the key there
+	template<typename Key, typename Alloc>
+	static inline cuckoo_set_iterator<Key> cuckoo_set_prepare_insert(cuckoo_set_table<Key, Alloc>* t, size_t keyhash) {
+		const size_t capacity = t->nbuckets * c_cuckoo_set_slots;
+		if (t->size + 1 > capacity - capacity / 10)
+			cuckoo_set_rehash(t, t->nbuckets ? t->nbuckets * 2 : 4, t->seed);
+
+		for (;;) {
+			const cuckoo_set_location location = cuckoo_set_locate(keyhash, t->seed, t->nbuckets - 1);
+
+			cuckoo_set_iterator<Key> result;
+			if (cuckoo_set_path(t, location, &result)) {
+				t->buckets[result.bucket - t->buckets].tags[result.slot] = location.tag;
+				++t->size;
+				return result;
+			}
+
+			// a new seed usually breaks up the collision; a table that is
+			// at least half full grows instead
+			const size_t nbuckets = (t->size * 2 < t->nbuckets * c_cuckoo_set_slots) ? t->nbuckets : t->nbuckets * 2;
+			cuckoo_set_rehash(t, nbuckets, t->seed + 0x9E3779B9u);
+		}
+	}
+
+	// Keys are reinserted through cuckoo_set_prepare_insert, so the new
+	// table may itself be rebuilt should an insert find no path
+	template<typename Key, typename Alloc>
+	static inline void cuckoo_set_rehash(cuckoo_set_table<Key, Alloc>* t, size_t nbuckets, size_t seed) {
+		typedef typename cuckoo_set_table<Key, Alloc>::bucket bucket;
+
+		const cuckoo_set_table<Key, Alloc> old = *t;
+
+		cuckoo_set_allocate(t, nbuckets);
+		t->size = 0;
+		t->seed = seed;
+		for (size_t bb = 0; bb != old.nbuckets; ++bb) {
+			for (size_t ss = 0; ss != c_cuckoo_set_slots; ++ss) {
+				if (!old.buckets[bb].tags[ss])
+					continue;
+
+				Key* src = old.buckets[bb].key(ss);
+				const cuckoo_set_iterator<Key> dst = cuckoo_set_prepare_insert(t, hash(*src));
+				buffer_move_urange((Key*)&*dst, src, src + 1);
+			}
+		}
+
+		if (old.buckets)
+			allocator_deallocate(static_cast<Alloc&>(*t), old.buckets, sizeof(bucket) * (old.nbuckets + 1), alignof(bucket));
+	}
+
+	// Sizes the table so count keys fit without growing
+	template<typename Key, typename Alloc>
+	static inline void cuckoo_set_reserve(cuckoo_set_table<Key, Alloc>* t, size_t count) {
+		size_t nbuckets = 4;
+		while (nbuckets * c_cuckoo_set_slots - nbuckets * c_cuckoo_set_slots / 10 < count)
+			nbuckets *= 2;
+		if (nbuckets > t->nbuckets)
+			cuckoo_set_rehash(t, nbuckets, t->seed);
+	}
+
+	template<typename Key, typename Alloc>
+	static inline void cuckoo_set_erase(cuckoo_set_table<Key, Alloc>* t, cuckoo_set_iterator<Key> where) {
+		cuckoo_set_bucket<Key>* b = t->buckets + (where.bucket - t->buckets);
+		b->key(where.slot)->~Key();
+		b->tags[where.slot] = 0;
+		--t->size;
+	}
+
+	// Keys keep their slots, so the copy takes the seed along with them
+	template<typename Key, typename Alloc>
+	static inline void cuckoo_set_copy(cuckoo_set_table<Key, Alloc>* t, const cuckoo_set_table<Key, Alloc>* other) {
+		t->seed = other->seed;
+		if (!other->nbuckets)
+			return;
+
+		cuckoo_set_allocate(t, other->nbuckets);
+		for (size_t bb = 0; bb != other->nbuckets; ++bb) {
+			const cuckoo_set_bucket<Key>& from = other->buckets[bb];
+			for (size_t ss = 0; ss != c_cuckoo_set_slots; ++ss) {
+				t->buckets[bb].tags[ss] = from.tags[ss];
+				if (from.tags[ss])
+					new(placeholder(), t->buckets[bb].key(ss)) Key(*from.key(ss));
+			}
+		}
+		t->size = other->size;
+	}
+
+	template<typename Key, typename Alloc>
+	static inline void cuckoo_set_swap(cuckoo_set_table<Key, Alloc>* t, cuckoo_set_table<Key, Alloc>* other) {
+		const cuckoo_set_table<Key, Alloc> tmp = *t;
+		*t = *other;
+		*other = tmp;
+	}
+
+	template<typename Key, typename Alloc>
+	static inline void cuckoo_set_move(cuckoo_set_table<Key, Alloc>* dst, cuckoo_set_table<Key, Alloc>* src) {
+		*dst = *src;
+		cuckoo_set_init(src);
+	}
+
+	// Bucketized cuckoo hash set: a lookup checks the key's two buckets and
+	// nothing else. An insert into two full buckets searches breadth-first
+	// for the shortest chain of displacements ending at a free slot, up to
+	// c_cuckoo_set_depth moves; if none exists the table is rebuilt under a
+	// new seed, or doubled when it is more than half full. Tables fill to
+	// 0.9 before growing.
+	//
+	// Inserting or erasing invalidates iterators and references.
+	template<typename Key, typename Alloc = TINYSTL_ALLOCATOR>
+	class cuckoo_set {
+	public:
+		cuckoo_set();
+		explicit cuckoo_set(const Alloc& alloc);
+		cuckoo_set(const cuckoo_set& other);
+		cuckoo_set(cuckoo_set&& other);
+		~cuckoo_set();
+
+		cuckoo_set& operator=(const cuckoo_set& other);
+		cuckoo_set& operator=(cuckoo_set&& other);
+
+		const Alloc& get_allocator() const;
+
+		typedef cuckoo_set_iterator<Key> const_iterator;
+		typedef const_iterator iterator;
+
+		iterator begin() const;
+		iterator end() const;
+
+		void clear();
+		bool empty() const;
+		size_t size() const;
+		size_t capacity() const;
+		void reserve(size_t size);
+
+		iterator find(const Key& key) const;
+		pair<iterator, bool> insert(const Key& key);
+		pair<iterator, bool> emplace(Key&& key);
+		void erase(iterator where);
+		size_t erase(const Key& key);
+
+		void swap(cuckoo_set& other);
+
+	private:
+		cuckoo_set_table<Key, Alloc> m_table;
+	};
+
+	template<typename Key, typename Alloc>
+	struct is_trivially_relocatable<cuckoo_set<Key, Alloc> > {
+		static const bool value = is_trivially_relocatable<Alloc>::value;
+	};
+
+	template<typename Key, typename Alloc>
+	inline cuckoo_set<Key, Alloc>::cuckoo_set() {
+		cuckoo_set_init(&m_table);
+	}
+
+	template<typename Key, typename Alloc>
+	inline cuckoo_set<Key, Alloc>::cuckoo_set(const Alloc& alloc)
+		: m_table(alloc)
+	{
+		cuckoo_set_init(&m_table);
+	}
+
+	template<typename Key, typename Alloc>
+	inline cuckoo_set<Key, Alloc>::cuckoo_set(const cuckoo_set& other)
+		: m_table(other.get_allocator())
+	{
+		cuckoo_set_init(&m_table);
+		cuckoo_set_copy(&m_table, &other.m_table);
+	}
+
+	template<typename Key, typename Alloc>
+	inline cuckoo_set<Key, Alloc>::cuckoo_set(cuckoo_set&& other)
+		: m_table(other.get_allocator())
+	{
+		cuckoo_set_move(&m_table, &other.m_table);
+	}
+
+	template<typename Key, typename Alloc>
+	inline cuckoo_set<Key, Alloc>::~cuckoo_set() {
+		cuckoo_set_destroy_keys(&m_table);
+		cuckoo_set_deallocate(&m_table);
+	}
+
+	template<typename Key, typename Alloc>
+	inline cuckoo_set<Key, Alloc>& cuckoo_set<Key, Alloc>::operator=(const cuckoo_set& other) {
+		cuckoo_set(other).swap(*this);
+		return *this;
+	}
+
+	template<typename Key, typename Alloc>
+	inline cuckoo_set<Key, Alloc>& cuckoo_set<Key, Alloc>::operator=(cuckoo_set&& other) {
+		cuckoo_set(static_cast<cuckoo_set&&>(other)).swap(*this);
+		return *this;
+	}
+
+	template<typename Key, typename Alloc>
+	inline const Alloc& cuckoo_set<Key, Alloc>::get_allocator() const {
+		return m_table;
+	}
+
+	template<typename Key, typename Alloc>
+	inline typename cuckoo_set<Key, Alloc>::iterator cuckoo_set<Key, Alloc>::begin() const {
+		return cuckoo_set_begin(&m_table);
+	}
+
+	template<typename Key, typename Alloc>
+	inline typename cuckoo_set<Key, Alloc>::iterator cuckoo_set<Key, Alloc>::end() const {
+		return cuckoo_set_end(&m_table);
+	}
+
+	template<typename Key, typename Alloc>
+	inline void cuckoo_set<Key, Alloc>::clear() {
+		cuckoo_set_clear(&m_table);
+	}
+
+	template<typename Key, typename Alloc>
+	inline bool cuckoo_set<Key, Alloc>::empty() const {
+		return m_table.size == 0;
+	}
+
+	template<typename Key, typename Alloc>
+	inline size_t cuckoo_set<Key, Alloc>::size() const {
+		return m_table.size;
+	}
+
+	template<typename Key, typename Alloc>
+	inline size_t cuckoo_set<Key, Alloc>::capacity() const {
+		return m_table.nbuckets * c_cuckoo_set_slots;
+	}
+
+	template<typename Key, typename Alloc>
+	inline void cuckoo_set<Key, Alloc>::reserve(size_t size) {
+		cuckoo_set_reserve(&m_table, size);
+	}
+
+	template<typename Key, typename Alloc>
+	inline typename cuckoo_set<Key, Alloc>::iterator cuckoo_set<Key, Alloc>::find(const Key& key) const {
+		return cuckoo_set_find(&m_table, key, hash(key));
+	}
+
+	template<typename Key, typename Alloc>
+	inline pair<typename cuckoo_set<Key, Alloc>::iterator, bool> cuckoo_set<Key, Alloc>::insert(const Key& key) {
+		pair<iterator, bool> result;
+		result.second = false;
+
+		const size_t keyhash = hash(key);
+		result.first = cuckoo_set_find(&m_table, key, keyhash);
+		if (result.first == end()) {
+			result.first = cuckoo_set_prepare_insert(&m_table, keyhash);
+			new(placeholder(), (Key*)&*result.first) Key(key);
+			result.second = true;
+		}
+
+		return result;
+	}
+
+	template<typename Key, typename Alloc>
+	inline pair<typename cuckoo_set<Key, Alloc>::iterator, bool> cuckoo_set<Key, Alloc>::emplace(Key&& key) {
+		pair<iterator, bool> result;
+		result.second = false;
+
+		const size_t keyhash = hash(key);
+		result.first = cuckoo_set_find(&m_table, key, keyhash);
+		if (result.first == end()) {
+			result.first = cuckoo_set_prepare_insert(&m_table, keyhash);
+			new(placeholder(), (Key*)&*result.first) Key(static_cast<Key&&>(key));
+			result.second = true;
+		}
+
+		return result;
+	}
+
+	template<typename Key, typename Alloc>
+	inline void cuckoo_set<Key, Alloc>::erase(iterator where) {
+		cuckoo_set_erase(&m_table, where);
+	}
+
+	template<typename Key, typename Alloc>
+	inline size_t cuckoo_set<Key, Alloc>::erase(const Key& key) {
+		const iterator where = cuckoo_set_find(&m_table, key, hash(key));
+		if (where == end())
+			return 0;
+
+		cuckoo_set_erase(&m_table, where);
+		return 1;
+	}
+
+	template<typename Key, typename Alloc>
+	inline void cuckoo_set<Key, Alloc>::swap(cuckoo_set& other) {
+		cuckoo_set_swap(&m_table, &other.m_table);
+	}
+}
+#endif
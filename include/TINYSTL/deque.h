@@ -0,0 +1,606 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TINYSTL_DEQUE_H
+#define TINYSTL_DEQUE_H
+
+#include <TINYSTL/allocator.h>
+#include <TINYSTL/new.h>
+#include <TINYSTL/stddef.h>
+#include <TINYSTL/traits.h>
+#include <string.h>
+
+namespace tinystl {
+
+	// Blocks hold a power of two elements, about 4KB worth but never fewer than 16
+	template<size_t ElementSize, size_t Shift = 12, bool fits = (Shift <= 4 || ElementSize <= (4096 >> Shift))>
+	struct deque_block_shift {
+		static const size_t next = Shift - 1;
+		static const size_t value = deque_block_shift<ElementSize, next>::value;
+	};
+
+	template<size_t ElementSize, size_t Shift>
+	struct deque_block_shift<ElementSize, Shift, true> {
+		static const size_t value = Shift;
+	};
+
+	// Addresses element index of a block map; the block size is part of the type
+	template<typename T>
+	struct deque_iterator {
+		static const size_t shift = deque_block_shift<sizeof(T)>::value;
+		static const size_t mask = ((size_t)1 << shift) - 1;
+
+		deque_iterator() {}
+		deque_iterator(T* const* blocks, size_t index) : blocks(blocks), index(index) {}
+		template<typename U>
+		deque_iterator(const deque_iterator<U>& other) : blocks(other.blocks), index(other.index) {}
+
+		T& operator*() const;
+		T* operator->() const;
+		T& operator[](ptrdiff_t n) const;
+
+		T* const* blocks;
+		size_t index;
+	};
+
+	template<typename T>
+	inline T& deque_iterator<T>::operator*() const {
+		return blocks[index >> shift][index & mask];
+	}
+
+	template<typename T>
+	inline T* deque_iterator<T>::operator->() const {
+		return &blocks[index >> shift][index & mask];
+	}
+
+	template<typename T>
+	inline T& deque_iterator<T>::operator[](ptrdiff_t n) const {
+		const size_t at = index + (size_t)n;
+		return blocks[at >> shift][at & mask];
+	}
+
+	template<typename T>
+	static inline deque_iterator<T>& operator++(deque_iterator<T>& lhs) {
+		++lhs.index;
+		return lhs;
+	}
+
+	template<typename T>
+	static inline deque_iterator<T> operator++(deque_iterator<T>& lhs, int) {
+		deque_iterator<T> result = lhs;
+		++lhs.index;
+		return result;
+	}
+
+	template<typename T>
+	static inline deque_iterator<T>& operator--(deque_iterator<T>& lhs) {
+		--lhs.index;
+		return lhs;
+	}
+
+	template<typename T>
+	static inline deque_iterator<T> operator--(deque_iterator<T>& lhs, int) {
+		deque_iterator<T> result = lhs;
+		--lhs.index;
+		return result;
+	}
+
+	template<typename T>
+	static inline deque_iterator<T>& operator+=(deque_iterator<T>& lhs, ptrdiff_t n) {
+		lhs.index += (size_t)n;
+		return lhs;
+	}
+
+	template<typename T>
+	static inline deque_iterator<T>& operator-=(deque_iterator<T>& lhs, ptrdiff_t n) {
+		lhs.index -= (size_t)n;
+		return lhs;
+	}
+
+	template<typename T>
+	static inline deque_iterator<T> operator+(const deque_iterator<T>& lhs, ptrdiff_t n) {
+		return deque_iterator<T>(lhs.blocks, lhs.index + (size_t)n);
+	}
+
+	template<typename T>
+	static inline deque_iterator<T> operator+(ptrdiff_t n, const deque_iterator<T>& rhs) {
+		return deque_iterator<T>(rhs.blocks, rhs.index + (size_t)n);
+	}
+
+	template<typename T>
+	static inline deque_iterator<T> operator-(const deque_iterator<T>& lhs, ptrdiff_t n) {
+		return deque_iterator<T>(lhs.blocks, lhs.index - (size_t)n);
+	}
+
+	template<typename L, typename R>
+	static inline ptrdiff_t operator-(const deque_iterator<L>& lhs, const deque_iterator<R>& rhs) {
+		return (ptrdiff_t)(lhs.index - rhs.index);
+	}
+
+	template<typename L, typename R>
+	static inline bool operator==(const deque_iterator<L>& lhs, const deque_iterator<R>& rhs) {
+		return lhs.index == rhs.index;
+	}
+
+	template<typename L, typename R>
+	static inline bool operator!=(const deque_iterator<L>& lhs, const deque_iterator<R>& rhs) {
+		return lhs.index != rhs.index;
+	}
+
+	template<typename L, typename R>
+	static inline bool operator<(const deque_iterator<L>& lhs, const deque_iterator<R>& rhs) {
+		return lhs.index < rhs.index;
+	}
+
+	template<typename L, typename R>
+	static inline bool operator>(const deque_iterator<L>& lhs, const deque_iterator<R>& rhs) {
+		return lhs.index > rhs.index;
+	}
+
+	template<typename L, typename R>
+	static inline bool operator<=(const deque_iterator<L>& lhs, const deque_iterator<R>& rhs) {
+		return lhs.index <= rhs.index;
+	}
+
+	template<typename L, typename R>
+	static inline bool operator>=(const deque_iterator<L>& lhs, const deque_iterator<R>& rhs) {
+		return lhs.index >= rhs.index;
+	}
+
+	// A double-ended queue built from fixed-size blocks. Growing at either
+	// end allocates at most one block and may copy the block map, but never
+	// moves elements, so references stay valid until the element is removed.
+	// Iterators are invalidated by pushes.
+	template<typename T, typename Alloc = TINYSTL_ALLOCATOR>
+	class deque {
+	public:
+		deque();
+		explicit deque(const Alloc& alloc);
+		deque(const deque& other);
+		deque(deque&& other);
+		~deque();
+
+		deque& operator=(const deque& other);
+		deque& operator=(deque&& other);
+
+		const Alloc& get_allocator() const;
+
+		size_t size() const;
+		bool empty() const;
+
+		T& operator[](size_t idx);
+		const T& operator[](size_t idx) const;
+
+		const T& front() const;
+		T& front();
+		const T& back() const;
+		T& back();
+
+		void resize(size_t size);
+		void resize(size_t size, const T& value);
+		void clear();
+		void shrink_to_fit();
+
+		void push_back(const T& t);
+		void push_back(T&& t);
+		void pop_back();
+
+		void push_front(const T& t);
+		void push_front(T&& t);
+		void pop_front();
+
+		template<typename... Args>
+		void emplace_back(Args&&... args);
+
+		template<typename... Args>
+		void emplace_front(Args&&... args);
+
+		void swap(deque& other);
+
+		typedef T value_type;
+
+		typedef deque_iterator<T> iterator;
+		iterator begin();
+		iterator end();
+
+		typedef deque_iterator<const T> const_iterator;
+		const_iterator begin() const;
+		const_iterator end() const;
+
+	private:
+		static const size_t block_shift = deque_block_shift<sizeof(T)>::value;
+		static const size_t block_size = (size_t)1 << block_shift;
+		static const size_t block_mask = block_size - 1;
+
+		T* slot(size_t index) const;
+		T* back_slot();
+		T* front_slot();
+		T* allocate_block();
+		void release_block(T* block);
+		void release_all();
+		void reserve_map(bool front);
+		void destroy_all();
+
+		struct storage : Alloc {
+			storage() {}
+			explicit storage(const Alloc& alloc) : Alloc(alloc) {}
+
+			T** map;
+			size_t mapcapacity;
+			size_t mapfirst;
+			size_t nblocks;
+			size_t offset;
+			size_t size;
+			T* spare;
+		};
+
+		storage m_storage;
+	};
+
+	// a deque only points at its block map, so it moves with its allocator
+	template<typename T, typename Alloc>
+	struct is_trivially_relocatable<deque<T, Alloc> > {
+		static const bool value = is_trivially_relocatable<Alloc>::value;
+	};
+
+	template<typename T, typename Alloc>
+	inline deque<T, Alloc>::deque() {
+		m_storage.map = 0;
+		m_storage.mapcapacity = m_storage.mapfirst = m_storage.nblocks = 0;
+		m_storage.offset = m_storage.size = 0;
+		m_storage.spare = 0;
+	}
+
+	template<typename T, typename Alloc>
+	inline deque<T, Alloc>::deque(const Alloc& alloc)
+		: m_storage(alloc)
+	{
+		m_storage.map = 0;
+		m_storage.mapcapacity = m_storage.mapfirst = m_storage.nblocks = 0;
+		m_storage.offset = m_storage.size = 0;
+		m_storage.spare = 0;
+	}
+
+	template<typename T, typename Alloc>
+	inline deque<T, Alloc>::deque(const deque& other)
+		: m_storage(other.get_allocator())
+	{
+		m_storage.map = 0;
+		m_storage.mapcapacity = m_storage.mapfirst = m_storage.nblocks = 0;
+		m_storage.offset = m_storage.size = 0;
+		m_storage.spare = 0;
+
+		for (const_iterator it = other.begin(), end = other.end(); it != end; ++it)
+			push_back(*it);
+	}
+
+	template<typename T, typename Alloc>
+	inline deque<T, Alloc>::deque(deque&& other)
+		: m_storage(other.m_storage)
+	{
+		other.m_storage.map = 0;
+		other.m_storage.mapcapacity = other.m_storage.mapfirst = other.m_storage.nblocks = 0;
+		other.m_storage.offset = other.m_storage.size = 0;
+		other.m_storage.spare = 0;
+	}
+
+	template<typename T, typename Alloc>
+	inline deque<T, Alloc>::~deque() {
+		destroy_all();
+	}
+
+	template<typename T, typename Alloc>
+	inline deque<T, Alloc>& deque<T, Alloc>::operator=(const deque& other) {
+		deque(other).swap(*this);
+		return *this;
+	}
+
+	template<typename T, typename Alloc>
+	inline deque<T, Alloc>& deque<T, Alloc>::operator=(deque&& other) {
+		destroy_all();
+		m_storage = other.m_storage;
+		other.m_storage.map = 0;
+		other.m_storage.mapcapacity = other.m_storage.mapfirst = other.m_storage.nblocks = 0;
+		other.m_storage.offset = other.m_storage.size = 0;
+		other.m_storage.spare = 0;
+		return *this;
+	}
+
+	template<typename T, typename Alloc>
+	inline const Alloc& deque<T, Alloc>::get_allocator() const {
+		return m_storage;
+	}
+
+	template<typename T, typename Alloc>
+	inline size_t deque<T, Alloc>::size() const {
+		return m_storage.size;
+	}
+
+	template<typename T, typename Alloc>
+	inline bool deque<T, Alloc>::empty() const {
+		return m_storage.size == 0;
+	}
+
+	template<typename T, typename Alloc>
+	inline T* deque<T, Alloc>::slot(size_t index) const {
+		index += m_storage.offset;
+		return m_storage.map[m_storage.mapfirst + (index >> block_shift)] + (index & block_mask);
+	}
+
+	template<typename T, typename Alloc>
+	inline T& deque<T, Alloc>::operator[](size_t idx) {
+		return *slot(idx);
+	}
+
+	template<typename T, typename Alloc>
+	inline const T& deque<T, Alloc>::operator[](size_t idx) const {
+		return *slot(idx);
+	}
+
+	template<typename T, typename Alloc>
+	inline const T& deque<T, Alloc>::front() const {
+		return *slot(0);
+	}
+
+	template<typename T, typename Alloc>
+	inline T& deque<T, Alloc>::front() {
+		return *slot(0);
+	}
+
+	template<typename T, typename Alloc>
+	inline const T& deque<T, Alloc>::back() const {
+		return *slot(m_storage.size - 1);
+	}
+
+	template<typename T, typename Alloc>
+	inline T& deque<T, Alloc>::back() {
+		return *slot(m_storage.size - 1);
+	}
+
+	template<typename T, typename Alloc>
+	inline void deque<T, Alloc>::resize(size_t size) {
+		while (m_storage.size > size)
+			pop_back();
+		while (m_storage.size < size)
+			emplace_back();
+	}
+
+	template<typename T, typename Alloc>
+	inline void deque<T, Alloc>::resize(size_t size, const T& value) {
+		while (m_storage.size > size)
+			pop_back();
+		while (m_storage.size < size)
+			push_back(value);
+	}
+
+	template<typename T, typename Alloc>
+	inline void deque<T, Alloc>::clear() {
+		while (m_storage.size)
+			pop_back();
+	}
+
+	template<typename T, typename Alloc>
+	inline void deque<T, Alloc>::shrink_to_fit() {
+		if (m_storage.spare) {
+			allocator_deallocate(static_cast<Alloc&>(m_storage), m_storage.spare, sizeof(T) * block_size, alignof(T));
+			m_storage.spare = 0;
+		}
+
+		if (!m_storage.nblocks && m_storage.map) {
+			allocator_deallocate(static_cast<Alloc&>(m_storage), m_storage.map, sizeof(T*) * m_storage.mapcapacity, alignof(T*));
+			m_storage.map = 0;
+			m_storage.mapcapacity = m_storage.mapfirst = 0;
+		}
+	}
+
+	template<typename T, typename Alloc>
+	inline T* deque<T, Alloc>::allocate_block() {
+		if (T* block = m_storage.spare) {
+			m_storage.spare = 0;
+			return block;
+		}
+		return (T*)allocator_allocate(static_cast<Alloc&>(m_storage), sizeof(T) * block_size, alignof(T));
+	}
+
+	// One emptied block is kept back so pushing and popping across a block
+	// boundary does not hit the allocator every time
+	template<typename T, typename Alloc>
+	inline void deque<T, Alloc>::release_block(T* block) {
+		if (m_storage.spare)
+			allocator_deallocate(static_cast<Alloc&>(m_storage), block, sizeof(T) * block_size, alignof(T));
+		else
+			m_storage.spare = block;
+	}
+
+	// An empty deque holds at most one block
+	template<typename T, typename Alloc>
+	inline void deque<T, Alloc>::release_all() {
+		if (m_storage.nblocks)
+			release_block(m_storage.map[m_storage.mapfirst]);
+		m_storage.nblocks = 0;
+		m_storage.offset = 0;
+	}
+
+	// Makes room in the map for one more block at the front or back. Only
+	// block pointers are copied.
+	template<typename T, typename Alloc>
+	inline void deque<T, Alloc>::reserve_map(bool front) {
+		const size_t nblocks = m_storage.nblocks;
+		if (front ? m_storage.mapfirst != 0 : m_storage.mapfirst + nblocks != m_storage.mapcapacity)
+			return;
+
+		T** map = m_storage.map;
+		size_t mapcapacity = m_storage.mapcapacity;
+		if (nblocks * 2 >= mapcapacity) {
+			mapcapacity = mapcapacity ? mapcapacity * 2 : 8;
+			map = (T**)allocator_allocate(static_cast<Alloc&>(m_storage), sizeof(T*) * mapcapacity, alignof(T*));
+		}
+
+		const size_t mapfirst = (mapcapacity - nblocks) / 2;
+		if (nblocks)
+			memmove(map + mapfirst, m_storage.map + m_storage.mapfirst, sizeof(T*) * nblocks);
+
+		if (map != m_storage.map) {
+			allocator_deallocate(static_cast<Alloc&>(m_storage), m_storage.map, sizeof(T*) * m_storage.mapcapacity, alignof(T*));
+			m_storage.map = map;
+			m_storage.mapcapacity = mapcapacity;
+		}
+		m_storage.mapfirst = mapfirst;
+	}
+
+	// Returns the uninitialized slot just past the back, adding a block if needed
+	template<typename T, typename Alloc>
+	inline T* deque<T, Alloc>::back_slot() {
+		const size_t index = m_storage.offset + m_storage.size;
+		if (index == (m_storage.nblocks << block_shift)) {
+			reserve_map(false);
+			m_storage.map[m_storage.mapfirst + m_storage.nblocks] = allocate_block();
+			++m_storage.nblocks;
+		}
+		return m_storage.map[m_storage.mapfirst + (index >> block_shift)] + (index & block_mask);
+	}
+
+	// Returns the uninitialized slot just before the front, adding a block if needed
+	template<typename T, typename Alloc>
+	inline T* deque<T, Alloc>::front_slot() {
+		if (m_storage.offset == 0) {
+			reserve_map(true);
+			m_storage.map[--m_storage.mapfirst] = allocate_block();
+			++m_storage.nblocks;
+			m_storage.offset = block_size;
+		}
+		const size_t index = m_storage.offset - 1;
+		return m_storage.map[m_storage.mapfirst + (index >> block_shift)] + (index & block_mask);
+	}
+
+	template<typename T, typename Alloc>
+	inline void deque<T, Alloc>::push_back(const T& t) {
+		// t may live in this deque, but adding a block never moves elements
+		new(placeholder(), back_slot()) T(t);
+		++m_storage.size;
+	}
+
+	template<typename T, typename Alloc>
+	inline void deque<T, Alloc>::push_back(T&& t) {
+		new(placeholder(), back_slot()) T(static_cast<T&&>(t));
+		++m_storage.size;
+	}
+
+	template<typename T, typename Alloc>
+	template<typename... Args>
+	inline void deque<T, Alloc>::emplace_back(Args&&... args) {
+		new(placeholder(), back_slot()) T(static_cast<Args&&>(args)...);
+		++m_storage.size;
+	}
+
+	template<typename T, typename Alloc>
+	inline void deque<T, Alloc>::push_front(const T& t) {
+		new(placeholder(), front_slot()) T(t);
+		--m_storage.offset;
+		++m_storage.size;
+	}
+
+	template<typename T, typename Alloc>
+	inline void deque<T, Alloc>::push_front(T&& t) {
+		new(placeholder(), front_slot()) T(static_cast<T&&>(t));
+		--m_storage.offset;
+		++m_storage.size;
+	}
+
+	template<typename T, typename Alloc>
+	template<typename... Args>
+	inline void deque<T, Alloc>::emplace_front(Args&&... args) {
+		new(placeholder(), front_slot()) T(static_cast<Args&&>(args)...);
+		--m_storage.offset;
+		++m_storage.size;
+	}
+
+	template<typename T, typename Alloc>
+	inline void deque<T, Alloc>::pop_back() {
+		slot(m_storage.size - 1)->~T();
+		if (!--m_storage.size) {
+			release_all();
+			return;
+		}
+
+		const size_t index = m_storage.offset + m_storage.size;
+		if (index == ((m_storage.nblocks - 1) << block_shift)) {
+			--m_storage.nblocks;
+			release_block(m_storage.map[m_storage.mapfirst + m_storage.nblocks]);
+		}
+	}
+
+	template<typename T, typename Alloc>
+	inline void deque<T, Alloc>::pop_front() {
+		slot(0)->~T();
+		if (!--m_storage.size) {
+			release_all();
+			return;
+		}
+
+		if (++m_storage.offset == block_size) {
+			release_block(m_storage.map[m_storage.mapfirst]);
+			++m_storage.mapfirst;
+			--m_storage.nblocks;
+			m_storage.offset = 0;
+		}
+	}
+
+	template<typename T, typename Alloc>
+	inline void deque<T, Alloc>::destroy_all() {
+		clear();
+		shrink_to_fit();
+	}
+
+	template<typename T, typename Alloc>
+	inline void deque<T, Alloc>::swap(deque& other) {
+		const storage tstorage = m_storage;
+		m_storage = other.m_storage;
+		other.m_storage = tstorage;
+	}
+
+	template<typename T, typename Alloc>
+	inline typename deque<T, Alloc>::iterator deque<T, Alloc>::begin() {
+		return iterator(m_storage.map + m_storage.mapfirst, m_storage.offset);
+	}
+
+	template<typename T, typename Alloc>
+	inline typename deque<T, Alloc>::iterator deque<T, Alloc>::end() {
+		return iterator(m_storage.map + m_storage.mapfirst, m_storage.offset + m_storage.size);
+	}
+
+	template<typename T, typename Alloc>
+	inline typename deque<T, Alloc>::const_iterator deque<T, Alloc>::begin() const {
+		return const_iterator(m_storage.map + m_storage.mapfirst, m_storage.offset);
+	}
+
+	template<typename T, typename Alloc>
+	inline typename deque<T, Alloc>::const_iterator deque<T, Alloc>::end() const {
+		return const_iterator(m_storage.map + m_storage.mapfirst, m_storage.offset + m_storage.size);
+	}
+}
+
+#endif
@@ -0,0 +1,428 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TINYSTL_FLAT_HASH_BASE_H
+#define TINYSTL_FLAT_HASH_BASE_H
+
+#include <TINYSTL/allocator.h>
+#include <TINYSTL/buffer.h>
+#include <TINYSTL/hash.h>
+#include <TINYSTL/hash_base.h>
+#include <TINYSTL/new.h>
+#include <TINYSTL/stddef.h>
+#include <TINYSTL/traits.h>
+#include <string.h>
+
+#ifndef TINYSTL_FLAT_HASH_SSE2
+#	if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#		define TINYSTL_FLAT_HASH_SSE2 1
+#	else
+#		define TINYSTL_FLAT_HASH_SSE2 0
+#	endif
+#endif
+
+#if TINYSTL_FLAT_HASH_SSE2
+#	include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#	include <intrin.h>
+#endif
+
+namespace tinystl {
+
+	// Open-addressing table in the style of Swiss tables. A control byte per
+	// slot is either empty, deleted, or the low 7 bits of the key's hash.
+	// Lookups hash to a 16-slot group and compare all 16 control bytes at
+	// once, touching slots only on a fragment match; a group with an empty
+	// byte ends the probe.
+	static const size_t c_flat_hash_group = 16;
+
+	static const signed char c_flat_hash_empty = -128;
+	static const signed char c_flat_hash_deleted = -2;
+	static const signed char c_flat_hash_sentinel = -1;
+
+	template<typename Key, typename Value>
+	struct flat_hash_slot {
+		typedef pair<Key, Value> type;
+		static const Key& key(const type& slot) { return slot.first; }
+	};
+
+	template<typename Key>
+	struct flat_hash_slot<Key, void> {
+		typedef Key type;
+		static const Key& key(const Key& slot) { return slot; }
+	};
+
+	static inline unsigned flat_hash_ctz(unsigned mask) {
+#if defined(__GNUC__) || defined(__clang__)
+		return (unsigned)__builtin_ctz(mask);
+#elif defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, mask);
+		return (unsigned)index;
+#else
+		unsigned index = 0;
+		for (; !(mask & 1); mask >>= 1)
+			++index;
+		return index;
+#endif
+	}
+
+	// Bit i of each result is set when control byte i of the group qualifies
+#if TINYSTL_FLAT_HASH_SSE2
+	static inline unsigned flat_hash_group_match(const signed char* group, signed char fragment) {
+		const __m128i ctrl = _mm_load_si128((const __m128i*)group);
+		return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(fragment)));
+	}
+
+	static inline unsigned flat_hash_group_empty(const signed char* group) {
+		return flat_hash_group_match(group, c_flat_hash_empty);
+	}
+
+	static inline unsigned flat_hash_group_available(const signed char* group) {
+		const __m128i ctrl = _mm_load_si128((const __m128i*)group);
+		return (unsigned)_mm_movemask_epi8(_mm_cmplt_epi8(ctrl, _mm_set1_epi8(c_flat_hash_sentinel)));
+	}
+#else
+	static inline unsigned flat_hash_group_match(const signed char* group, signed char fragment) {
+		unsigned mask = 0;
+		for (size_t ii = 0; ii != c_flat_hash_group; ++ii)
+			mask |= (unsigned)(group[ii] == fragment) << ii;
+		return mask;
+	}
+
+	static inline unsigned flat_hash_group_empty(const signed char* group) {
+		return flat_hash_group_match(group, c_flat_hash_empty);
+	}
+
+	static inline unsigned flat_hash_group_available(const signed char* group) {
+		unsigned mask = 0;
+		for (size_t ii = 0; ii != c_flat_hash_group; ++ii)
+			mask |= (unsigned)(group[ii] < c_flat_hash_sentinel) << ii;
+		return mask;
+	}
+#endif
+
+	template<typename Key, typename Value, typename Alloc>
+	struct flat_hash_table : Alloc {
+		typedef typename flat_hash_slot<Key, Value>::type slot;
+
+		flat_hash_table() {}
+		explicit flat_hash_table(const Alloc& alloc) : Alloc(alloc) {}
+
+		signed char* ctrl;
+		slot* slots;
+		size_t capacity;
+		size_t size;
+		size_t growth_left;
+	};
+
+	template<typename Key, typename Value, typename Alloc>
+	static inline void flat_hash_init(flat_hash_table<Key, Value, Alloc>* t) {
+		t->ctrl = 0;
+		t->slots = 0;
+		t->capacity = t->size = t->growth_left = 0;
+	}
+
+	// Control bytes (plus the sentinel that stops iteration) and slots share
+	// one block
+	template<typename Slot>
+	static inline size_t flat_hash_ctrl_bytes(size_t capacity) {
+		return (capacity + 1 + alignof(Slot) - 1) & ~(alignof(Slot) - 1);
+	}
+
+	template<typename Slot>
+	static inline size_t flat_hash_alignment() {
+		return (alignof(Slot) > c_flat_hash_group) ? alignof(Slot) : c_flat_hash_group;
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	static inline void flat_hash_allocate(flat_hash_table<Key, Value, Alloc>* t, size_t capacity) {
+		typedef typename flat_hash_table<Key, Value, Alloc>::slot slot;
+
+		const size_t ctrlbytes = flat_hash_ctrl_bytes<slot>(capacity);
+		char* block = (char*)allocator_allocate(static_cast<Alloc&>(*t), ctrlbytes + sizeof(slot) * capacity, flat_hash_alignment<slot>());
+
+		t->ctrl = (signed char*)block;
+		t->slots = (slot*)(block + ctrlbytes);
+		t->capacity = capacity;
+		t->growth_left = capacity - capacity / 8;
+		memset(t->ctrl, c_flat_hash_empty, capacity);
+		t->ctrl[capacity] = c_flat_hash_sentinel;
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	static inline void flat_hash_deallocate(flat_hash_table<Key, Value, Alloc>* t) {
+		typedef typename flat_hash_table<Key, Value, Alloc>::slot slot;
+
+		if (t->ctrl)
+			allocator_deallocate(static_cast<Alloc&>(*t), t->ctrl, flat_hash_ctrl_bytes<slot>(t->capacity) + sizeof(slot) * t->capacity, flat_hash_alignment<slot>());
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	static inline void flat_hash_destroy_slots(flat_hash_table<Key, Value, Alloc>* t) {
+		typedef typename flat_hash_table<Key, Value, Alloc>::slot slot;
+
+		for (size_t ii = 0; ii != t->capacity; ++ii) {
+			if (t->ctrl[ii] >= 0)
+				t->slots[ii].~slot();
+		}
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	static inline void flat_hash_clear(flat_hash_table<Key, Value, Alloc>* t) {
+		flat_hash_destroy_slots(t);
+		if (t->capacity) {
+			memset(t->ctrl, c_flat_hash_empty, t->capacity);
+			t->growth_left = t->capacity - t->capacity / 8;
+		}
+		t->size = 0;
+	}
+
+	// Returns the index holding key, or capacity if it is not present
+	template<typename Key, typename Value, typename Alloc>
+	static inline size_t flat_hash_find(const flat_hash_table<Key, Value, Alloc>* t, const Key& key, size_t keyhash) {
+		typedef flat_hash_slot<Key, Value> slot_traits;
+
+		if (!t->capacity)
+			return 0;
+
+		const signed char fragment = (signed char)(keyhash & 0x7f);
+		const size_t groupmask = t->capacity / c_flat_hash_group - 1;
+		size_t group = (keyhash >> 7) & groupmask;
+		for (size_t step = 1; ; ++step) {
+			const signed char* ctrl = t->ctrl + group * c_flat_hash_group;
+			for (unsigned match = flat_hash_group_match(ctrl, fragment); match; match &= match - 1) {
+				const size_t index = group * c_flat_hash_group + flat_hash_ctz(match);
+				if (slot_traits::key(t->slots[index]) == key)
+					return index;
+			}
+
+			if (flat_hash_group_empty(ctrl) || step > groupmask)
+				return t->capacity;
+			group = (group + step) & groupmask;
+		}
+	}
+
+	// Returns the first empty or deleted index on keyhash's probe sequence
+	template<typename Key, typename Value, typename Alloc>
+	static inline size_t flat_hash_find_available(const flat_hash_table<Key, Value, Alloc>* t, size_t keyhash) {
+		const size_t groupmask = t->capacity / c_flat_hash_group - 1;
+		size_t group = (keyhash >> 7) & groupmask;
+		for (size_t step = 1; ; ++step) {
+			const unsigned available = flat_hash_group_available(t->ctrl + group * c_flat_hash_group);
+			if (available)
+				return group * c_flat_hash_group + flat_hash_ctz(available);
+			group = (group + step) & groupmask;
+		}
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	static inline void flat_hash_resize(flat_hash_table<Key, Value, Alloc>* t, size_t capacity) {
+		typedef flat_hash_slot<Key, Value> slot_traits;
+		typedef typename flat_hash_table<Key, Value, Alloc>::slot slot;
+
+		signed char* oldctrl = t->ctrl;
+		slot* oldslots = t->slots;
+		const size_t oldcapacity = t->capacity;
+
+		flat_hash_allocate(t, capacity);
+		for (size_t ii = 0; ii != oldcapacity; ++ii) {
+			if (oldctrl[ii] < 0)
+				continue;
+
+			const size_t keyhash = hash(slot_traits::key(oldslots[ii]));
+			const size_t index = flat_hash_find_available(t, keyhash);
+			t->ctrl[index] = (signed char)(keyhash & 0x7f);
+			buffer_move_urange(t->slots + index, oldslots + ii, oldslots + ii + 1);
+		}
+		t->growth_left -= t->size;
+
+		if (oldctrl)
+			allocator_deallocate(static_cast<Alloc&>(*t), oldctrl, flat_hash_ctrl_bytes<slot>(oldcapacity) + sizeof(slot) * oldcapacity, flat_hash_alignment<slot>());
+	}
+
+	// Claims a slot for a key known to be absent and returns its index; the
+	// caller constructs the element there
+	template<typename Key, typename Value, typename Alloc>
+	static inline size_t flat_hash_prepare_insert(flat_hash_table<Key, Value, Alloc>* t, size_t keyhash) {
+		size_t index = t->capacity ? flat_hash_find_available(t, keyhash) : 0;
+		if (!t->growth_left && (!t->capacity || t->ctrl[index] != c_flat_hash_deleted)) {
+			// out of empty slots: drop tombstones if they hold enough of the
+			// table, otherwise double
+			if (t->capacity && t->size * 32 <= t->capacity * 25)
+				flat_hash_resize(t, t->capacity);
+			else
+				flat_hash_resize(t, t->capacity ? t->capacity * 2 : c_flat_hash_group);
+			index = flat_hash_find_available(t, keyhash);
+		}
+
+		if (t->ctrl[index] == c_flat_hash_empty)
+			--t->growth_left;
+		t->ctrl[index] = (signed char)(keyhash & 0x7f);
+		++t->size;
+		return index;
+	}
+
+	// A slot can go back to empty when its group still has an empty byte:
+	// no probe ever continued past this group
+	template<typename Key, typename Value, typename Alloc>
+	static inline void flat_hash_erase(flat_hash_table<Key, Value, Alloc>* t, size_t index) {
+		typedef typename flat_hash_table<Key, Value, Alloc>::slot slot;
+
+		t->slots[index].~slot();
+		if (flat_hash_group_empty(t->ctrl + (index & ~(c_flat_hash_group - 1)))) {
+			t->ctrl[index] = c_flat_hash_empty;
+			++t->growth_left;
+		} else {
+			t->ctrl[index] = c_flat_hash_deleted;
+		}
+		--t->size;
+	}
+
+	// Sizes the table so count elements fit without growing
+	template<typename Key, typename Value, typename Alloc>
+	static inline void flat_hash_reserve(flat_hash_table<Key, Value, Alloc>* t, size_t count) {
+		size_t capacity = c_flat_hash_group;
+		while (capacity - capacity / 8 < count)
+			capacity *= 2;
+		if (capacity > t->capacity)
+			flat_hash_resize(t, capacity);
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	static inline void flat_hash_copy(flat_hash_table<Key, Value, Alloc>* t, const flat_hash_table<Key, Value, Alloc>* other) {
+		typedef typename flat_hash_table<Key, Value, Alloc>::slot slot;
+
+		if (!other->capacity)
+			return;
+
+		flat_hash_allocate(t, other->capacity);
+		memcpy(t->ctrl, other->ctrl, other->capacity);
+		for (size_t ii = 0; ii != other->capacity; ++ii) {
+			if (other->ctrl[ii] >= 0)
+				new(placeholder(), t->slots + ii) slot(other->slots[ii]);
+		}
+		t->size = other->size;
+		t->growth_left = other->growth_left;
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	static inline void flat_hash_swap(flat_hash_table<Key, Value, Alloc>* t, flat_hash_table<Key, Value, Alloc>* other) {
+		const flat_hash_table<Key, Value, Alloc> tmp = *t;
+		*t = *other;
+		*other = tmp;
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	static inline void flat_hash_move(flat_hash_table<Key, Value, Alloc>* dst, flat_hash_table<Key, Value, Alloc>* src) {
+		*dst = *src;
+		flat_hash_init(src);
+	}
+
+	template<typename Slot>
+	struct flat_hash_iterator {
+		Slot* operator->() const;
+		Slot& operator*() const;
+
+		const signed char* ctrl;
+		Slot* slot;
+	};
+
+	template<typename Slot>
+	struct flat_hash_iterator<const Slot> {
+		flat_hash_iterator() {}
+		flat_hash_iterator(flat_hash_iterator<Slot> other)
+			: ctrl(other.ctrl)
+			, slot(other.slot)
+		{
+		}
+
+		const Slot* operator->() const;
+		const Slot& operator*() const;
+
+		const signed char* ctrl;
+		const Slot* slot;
+	};
+
+	template<typename LSlot, typename RSlot>
+	static inline bool operator==(const flat_hash_iterator<LSlot>& lhs, const flat_hash_iterator<RSlot>& rhs) {
+		return lhs.ctrl == rhs.ctrl;
+	}
+
+	template<typename LSlot, typename RSlot>
+	static inline bool operator!=(const flat_hash_iterator<LSlot>& lhs, const flat_hash_iterator<RSlot>& rhs) {
+		return lhs.ctrl != rhs.ctrl;
+	}
+
+	// skips to the next full slot, stopping at the sentinel after the last one
+	template<typename Slot>
+	static inline void operator++(flat_hash_iterator<Slot>& lhs) {
+		do {
+			++lhs.ctrl;
+			++lhs.slot;
+		} while (*lhs.ctrl < c_flat_hash_sentinel);
+	}
+
+	template<typename Slot>
+	inline Slot* flat_hash_iterator<Slot>::operator->() const {
+		return slot;
+	}
+
+	template<typename Slot>
+	inline Slot& flat_hash_iterator<Slot>::operator*() const {
+		return *slot;
+	}
+
+	template<typename Slot>
+	inline const Slot* flat_hash_iterator<const Slot>::operator->() const {
+		return slot;
+	}
+
+	template<typename Slot>
+	inline const Slot& flat_hash_iterator<const Slot>::operator*() const {
+		return *slot;
+	}
+
+	template<typename Slot, typename Key, typename Value, typename Alloc>
+	static inline flat_hash_iterator<Slot> flat_hash_make_iterator(const flat_hash_table<Key, Value, Alloc>* t, size_t index) {
+		flat_hash_iterator<Slot> it;
+		it.ctrl = t->ctrl + index;
+		it.slot = t->slots + index;
+		return it;
+	}
+
+	template<typename Slot, typename Key, typename Value, typename Alloc>
+	static inline flat_hash_iterator<Slot> flat_hash_begin(const flat_hash_table<Key, Value, Alloc>* t) {
+		flat_hash_iterator<Slot> it = flat_hash_make_iterator<Slot>(t, 0);
+		if (t->capacity && *it.ctrl < c_flat_hash_sentinel)
+			++it;
+		return it;
+	}
+}
+
+#endif
@@ -0,0 +1,223 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TINYSTL_FLAT_HASH_SET_H
+#define TINYSTL_FLAT_HASH_SET_H
+
+#include <TINYSTL/flat_hash_base.h>
+
+namespace tinystl {
+
+	// Open-addressing set storing its keys inline in one array. Inserting or
+	// erasing invalidates iterators and references.
+	template<typename Key, typename Alloc = TINYSTL_ALLOCATOR>
+	class flat_hash_set {
+	public:
+		flat_hash_set();
+		explicit flat_hash_set(const Alloc& alloc);
+		flat_hash_set(const flat_hash_set& other);
+		flat_hash_set(flat_hash_set&& other);
+		~flat_hash_set();
+
+		flat_hash_set& operator=(const flat_hash_set& other);
+		flat_hash_set& operator=(flat_hash_set&& other);
+
+		const Alloc& get_allocator() const;
+
+		typedef flat_hash_iterator<const Key> const_iterator;
+		typedef const_iterator iterator;
+
+		iterator begin() const;
+		iterator end() const;
+
+		void clear();
+		bool empty() const;
+		size_t size() const;
+		size_t capacity() const;
+		void reserve(size_t size);
+
+		iterator find(const Key& key) const;
+		pair<iterator, bool> insert(const Key& key);
+		pair<iterator, bool> emplace(Key&& key);
+		void erase(iterator where);
+		size_t erase(const Key& key);
+
+		void swap(flat_hash_set& other);
+
+	private:
+		flat_hash_table<Key, void, Alloc> m_table;
+	};
+
+	template<typename Key, typename Alloc>
+	struct is_trivially_relocatable<flat_hash_set<Key, Alloc> > {
+		static const bool value = is_trivially_relocatable<Alloc>::value;
+	};
+
+	template<typename Key, typename Alloc>
+	inline flat_hash_set<Key, Alloc>::flat_hash_set() {
+		flat_hash_init(&m_table);
+	}
+
+	template<typename Key, typename Alloc>
+	inline flat_hash_set<Key, Alloc>::flat_hash_set(const Alloc& alloc)
+		: m_table(alloc)
+	{
+		flat_hash_init(&m_table);
+	}
+
+	template<typename Key, typename Alloc>
+	inline flat_hash_set<Key, Alloc>::flat_hash_set(const flat_hash_set& other)
+		: m_table(other.get_allocator())
+	{
+		flat_hash_init(&m_table);
+		flat_hash_copy(&m_table, &other.m_table);
+	}
+
+	template<typename Key, typename Alloc>
+	inline flat_hash_set<Key, Alloc>::flat_hash_set(flat_hash_set&& other)
+		: m_table(other.get_allocator())
+	{
+		flat_hash_move(&m_table, &other.m_table);
+	}
+
+	template<typename Key, typename Alloc>
+	inline flat_hash_set<Key, Alloc>::~flat_hash_set() {
+		flat_hash_destroy_slots(&m_table);
+		flat_hash_deallocate(&m_table);
+	}
+
+	template<typename Key, typename Alloc>
+	inline flat_hash_set<Key, Alloc>& flat_hash_set<Key, Alloc>::operator=(const flat_hash_set& other) {
+		flat_hash_set(other).swap(*this);
+		return *this;
+	}
+
+	template<typename Key, typename Alloc>
+	inline flat_hash_set<Key, Alloc>& flat_hash_set<Key, Alloc>::operator=(flat_hash_set&& other) {
+		flat_hash_set(static_cast<flat_hash_set&&>(other)).swap(*this);
+		return *this;
+	}
+
+	template<typename Key, typename Alloc>
+	inline const Alloc& flat_hash_set<Key, Alloc>::get_allocator() const {
+		return m_table;
+	}
+
+	template<typename Key, typename Alloc>
+	inline typename flat_hash_set<Key, Alloc>::iterator flat_hash_set<Key, Alloc>::begin() const {
+		return flat_hash_begin<const Key>(&m_table);
+	}
+
+	template<typename Key, typename Alloc>
+	inline typename flat_hash_set<Key, Alloc>::iterator flat_hash_set<Key, Alloc>::end() const {
+		return flat_hash_make_iterator<const Key>(&m_table, m_table.capacity);
+	}
+
+	template<typename Key, typename Alloc>
+	inline void flat_hash_set<Key, Alloc>::clear() {
+		flat_hash_clear(&m_table);
+	}
+
+	template<typename Key, typename Alloc>
+	inline bool flat_hash_set<Key, Alloc>::empty() const {
+		return m_table.size == 0;
+	}
+
+	template<typename Key, typename Alloc>
+	inline size_t flat_hash_set<Key, Alloc>::size() const {
+		return m_table.size;
+	}
+
+	template<typename Key, typename Alloc>
+	inline size_t flat_hash_set<Key, Alloc>::capacity() const {
+		return m_table.capacity;
+	}
+
+	template<typename Key, typename Alloc>
+	inline void flat_hash_set<Key, Alloc>::reserve(size_t size) {
+		flat_hash_reserve(&m_table, size);
+	}
+
+	template<typename Key, typename Alloc>
+	inline typename flat_hash_set<Key, Alloc>::iterator flat_hash_set<Key, Alloc>::find(const Key& key) const {
+		return flat_hash_make_iterator<const Key>(&m_table, flat_hash_find(&m_table, key, hash(key)));
+	}
+
+	template<typename Key, typename Alloc>
+	inline pair<typename flat_hash_set<Key, Alloc>::iterator, bool> flat_hash_set<Key, Alloc>::insert(const Key& key) {
+		pair<iterator, bool> result;
+		result.second = false;
+
+		const size_t keyhash = hash(key);
+		size_t index = flat_hash_find(&m_table, key, keyhash);
+		if (index == m_table.capacity) {
+			index = flat_hash_prepare_insert(&m_table, keyhash);
+			new(placeholder(), m_table.slots + index) Key(key);
+			result.second = true;
+		}
+
+		result.first = flat_hash_make_iterator<const Key>(&m_table, index);
+		return result;
+	}
+
+	template<typename Key, typename Alloc>
+	inline pair<typename flat_hash_set<Key, Alloc>::iterator, bool> flat_hash_set<Key, Alloc>::emplace(Key&& key) {
+		pair<iterator, bool> result;
+		result.second = false;
+
+		const size_t keyhash = hash(key);
+		size_t index = flat_hash_find(&m_table, key, keyhash);
+		if (index == m_table.capacity) {
+			index = flat_hash_prepare_insert(&m_table, keyhash);
+			new(placeholder(), m_table.slots + index) Key(static_cast<Key&&>(key));
+			result.second = true;
+		}
+
+		result.first = flat_hash_make_iterator<const Key>(&m_table, index);
+		return result;
+	}
+
+	template<typename Key, typename Alloc>
+	inline void flat_hash_set<Key, Alloc>::erase(iterator where) {
+		flat_hash_erase(&m_table, (size_t)(where.slot - m_table.slots));
+	}
+
+	template<typename Key, typename Alloc>
+	inline size_t flat_hash_set<Key, Alloc>::erase(const Key& key) {
+		const size_t index = flat_hash_find(&m_table, key, hash(key));
+		if (index == m_table.capacity)
+			return 0;
+
+		flat_hash_erase(&m_table, index);
+		return 1;
+	}
+
+	template<typename Key, typename Alloc>
+	inline void flat_hash_set<Key, Alloc>::swap(flat_hash_set& other) {
+		flat_hash_swap(&m_table, &other.m_table);
+	}
+}
+#endif
@@ -0,0 +1,83 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TINYSTL_GROWTH_H
+#define TINYSTL_GROWTH_H
+
+#include <TINYSTL/allocator.h>
+#include <TINYSTL/traits.h>
+
+namespace tinystl {
+
+	// Geometric growth of the current capacity by Num/Den:
+	// growth_factor<2, 1> for append-heavy buffers, growth_factor<5, 4> for
+	// long-lived containers where slack costs more than copying.
+	template<size_t Num, size_t Den>
+	struct growth_factor {
+		static size_t grow(size_t oldbytes, size_t newbytes) {
+			const size_t bytes = (oldbytes * Num) / Den;
+			return (bytes < newbytes) ? newbytes : bytes;
+		}
+	};
+
+	// Grows by half until Threshold bytes, then by a quarter rounded up to
+	// whole PageSize pages, so large blocks waste less than a page of slack
+	// beyond the quarter. Growth stays geometric either way: a block that
+	// cannot be resized in place (elements that are not trivially
+	// relocatable, or an allocator without mremap) is still copied only
+	// O(log n) times.
+	template<size_t PageSize = 4096, size_t Threshold = TINYSTL_ALLOCATOR_MMAP_THRESHOLD>
+	struct growth_page_granular {
+		static size_t grow(size_t oldbytes, size_t newbytes) {
+			if (newbytes < Threshold)
+				return (newbytes * 3) / 2;
+
+			size_t bytes = oldbytes + oldbytes / 4;
+			if (bytes < newbytes)
+				bytes = newbytes;
+			return (bytes + PageSize - 1) & ~(PageSize - 1);
+		}
+	};
+
+	// Adds a growth policy to an allocator; everything else is inherited.
+	//   tinystl::vector<char, tinystl::growth_allocator<tinystl::growth_factor<2, 1> > > ingest;
+	template<typename Policy, typename Alloc = TINYSTL_ALLOCATOR>
+	struct growth_allocator : Alloc {
+		growth_allocator() {}
+		explicit growth_allocator(const Alloc& alloc) : Alloc(alloc) {}
+
+		static size_t static_grow(size_t oldbytes, size_t newbytes) {
+			return Policy::grow(oldbytes, newbytes);
+		}
+	};
+
+	template<typename Policy, typename Alloc>
+	struct is_trivially_relocatable<growth_allocator<Policy, Alloc> > {
+		static const bool value = is_trivially_relocatable<Alloc>::value;
+	};
+}
+
+#endif
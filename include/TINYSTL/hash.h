@@ -28,19 +28,104 @@
 #define TINYSTL_STRINGHASH_H
 
 #include <TINYSTL/stddef.h>
+#include <string.h>
+
+#if defined(_MSC_VER) && defined(_M_X64) && !defined(__clang__)
+#	include <intrin.h>
+#endif
 
 namespace tinystl {
 
+	// 64x64->128 bit multiply, leaving the low half in a and the high in b
+	static inline void hash_mum(unsigned long long* a, unsigned long long* b) {
+#if defined(__SIZEOF_INT128__)
+		const unsigned __int128 r = (unsigned __int128)*a * *b;
+		*a = (unsigned long long)r;
+		*b = (unsigned long long)(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64) && !defined(__clang__)
+		*a = _umul128(*a, *b, b);
+#else
+		const unsigned long long ha = *a >> 32, hb = *b >> 32, la = (unsigned int)*a, lb = (unsigned int)*b;
+		const unsigned long long rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+		const unsigned long long t = rl + (rm0 << 32);
+		unsigned long long carry = t < rl;
+		const unsigned long long lo = t + (rm1 << 32);
+		carry += lo < t;
+		*a = lo;
+		*b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif
+	}
+
+	static inline unsigned long long hash_mix(unsigned long long a, unsigned long long b) {
+		hash_mum(&a, &b);
+		return a ^ b;
+	}
+
+	static inline unsigned long long hash_read8(const unsigned char* p) {
+		unsigned long long value;
+		memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	static inline unsigned long long hash_read4(const unsigned char* p) {
+		unsigned int value;
+		memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
 	static inline size_t hash_string(const char* str, size_t len) {
-		// Implementation of sdbm a public domain string hash from Ozan Yigit
-		// see: http://www.eecs.harvard.edu/margo/papers/usenix91/paper.ps
+		// Implementation of wyhash (final version 4), a public domain hash
+		// from Wang Yi; see: https://github.com/wangyi-fudan/wyhash
+		// Reads 8 to 48 bytes per step through 64x64->128 bit multiplies.
+		// Words are read in native byte order, so values differ between
+		// little and big endian machines.
+
+		static const unsigned long long secret[4] = {
+			0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull,
+		};
+
+		const unsigned char* p = (const unsigned char*)str;
+		unsigned long long seed = hash_mix(secret[0], secret[1]);
+		unsigned long long a, b;
+		if (len <= 16) {
+			if (len >= 4) {
+				const size_t mid = (len >> 3) << 2;
+				a = (hash_read4(p) << 32) | hash_read4(p + mid);
+				b = (hash_read4(p + len - 4) << 32) | hash_read4(p + len - 4 - mid);
+			} else if (len) {
+				a = ((unsigned long long)p[0] << 16) | ((unsigned long long)p[len >> 1] << 8) | p[len - 1];
+				b = 0;
+			} else {
+				a = b = 0;
+			}
+		} else {
+			size_t remaining = len;
+			if (remaining > 48) {
+				unsigned long long see1 = seed, see2 = seed;
+				do {
+					seed = hash_mix(hash_read8(p) ^ secret[1], hash_read8(p + 8) ^ seed);
+					see1 = hash_mix(hash_read8(p + 16) ^ secret[2], hash_read8(p + 24) ^ see1);
+					see2 = hash_mix(hash_read8(p + 32) ^ secret[3], hash_read8(p + 40) ^ see2);
+					p += 48;
+					remaining -= 48;
+				} while (remaining > 48);
+				seed ^= see1 ^ see2;
+			}
+
+			while (remaining > 16) {
+				seed = hash_mix(hash_read8(p) ^ secret[1], hash_read8(p + 8) ^ seed);
+				p += 16;
+				remaining -= 16;
+			}
 
-		size_t hash = 0;
-		typedef const char* pointer;
-		for (pointer it = str, end = str + len; it != end; ++it)
-			hash = *it + (hash << 6) + (hash << 16) - hash;
+			a = hash_read8(p + remaining - 16);
+			b = hash_read8(p + remaining - 8);
+		}
 
-		return hash;
+		a ^= secret[1];
+		b ^= seed;
+		hash_mum(&a, &b);
+		return (size_t)hash_mix(a ^ secret[0] ^ len, b ^ secret[1]);
 	}
 
 	template<typename T>
@@ -27,6 +27,7 @@
 #ifndef TINYSTL_HASH_BASE_H
 #define TINYSTL_HASH_BASE_H
 
+#include <TINYSTL/allocator.h>
 #include <TINYSTL/stddef.h>
 #include <TINYSTL/traits.h>
 
@@ -47,6 +48,11 @@ namespace tinystl {
 		Value second;
 	};
 
+	template<typename Key, typename Value>
+	struct is_trivially_relocatable<pair<Key, Value> > {
+		static const bool value = is_trivially_relocatable<Key>::value && is_trivially_relocatable<Value>::value;
+	};
+
 	template<typename Key, typename Value>
 	inline pair<Key, Value>::pair() {
 	}
@@ -156,6 +162,93 @@ namespace tinystl {
 	{
 	}
 
+	template<typename Node>
+	struct unordered_hash_node_pool {
+		struct slab {
+			slab* next;
+			size_t nnodes;
+		};
+
+		void* freelist;
+		slab* slabs;
+		char* cursor;
+		char* end;
+	};
+
+	template<typename Node>
+	static inline void unordered_hash_pool_init(unordered_hash_node_pool<Node>* pool) {
+		pool->freelist = 0;
+		pool->slabs = 0;
+		pool->cursor = pool->end = 0;
+	}
+
+	template<typename Node>
+	static inline size_t unordered_hash_pool_header() {
+		typedef typename unordered_hash_node_pool<Node>::slab slab;
+		return (sizeof(slab) + alignof(Node) - 1) & ~(alignof(Node) - 1);
+	}
+
+	template<typename Node, typename Alloc>
+	static inline void* unordered_hash_pool_allocate(unordered_hash_node_pool<Node>* pool, Alloc& alloc) {
+		typedef typename unordered_hash_node_pool<Node>::slab slab;
+
+		if (pool->freelist) {
+			void* node = pool->freelist;
+			pool->freelist = *(void**)node;
+			return node;
+		}
+
+		if (pool->cursor == pool->end) {
+			// slabs double in size up to 1024 nodes so small containers stay small
+			size_t nnodes = pool->slabs ? pool->slabs->nnodes * 2 : 16;
+			if (nnodes > 1024)
+				nnodes = 1024;
+
+			slab* newslab = (slab*)allocator_allocate(alloc, unordered_hash_pool_header<Node>() + nnodes * sizeof(Node), alignof(Node));
+			newslab->next = pool->slabs;
+			newslab->nnodes = nnodes;
+			pool->slabs = newslab;
+			pool->cursor = (char*)newslab + unordered_hash_pool_header<Node>();
+			pool->end = pool->cursor + nnodes * sizeof(Node);
+		}
+
+		void* node = pool->cursor;
+		pool->cursor += sizeof(Node);
+		return node;
+	}
+
+	template<typename Node>
+	static inline void unordered_hash_pool_deallocate(unordered_hash_node_pool<Node>* pool, void* node) {
+		*(void**)node = pool->freelist;
+		pool->freelist = node;
+	}
+
+	template<typename Node, typename Alloc>
+	static inline void unordered_hash_pool_destroy(unordered_hash_node_pool<Node>* pool, Alloc& alloc) {
+		typedef typename unordered_hash_node_pool<Node>::slab slab;
+
+		for (slab* it = pool->slabs; it; ) {
+			slab* next = it->next;
+			allocator_deallocate(alloc, it, unordered_hash_pool_header<Node>() + it->nnodes * sizeof(Node), alignof(Node));
+			it = next;
+		}
+
+		unordered_hash_pool_init(pool);
+	}
+
+	template<typename Node>
+	static inline void unordered_hash_pool_swap(unordered_hash_node_pool<Node>* pool, unordered_hash_node_pool<Node>* other) {
+		const unordered_hash_node_pool<Node> tpool = *pool;
+		*pool = *other;
+		*other = tpool;
+	}
+
+	template<typename Node>
+	static inline void unordered_hash_pool_move(unordered_hash_node_pool<Node>* dst, unordered_hash_node_pool<Node>* src) {
+		*dst = *src;
+		unordered_hash_pool_init(src);
+	}
+
 	template<typename Key, typename Value>
 	static inline void unordered_hash_node_insert(unordered_hash_node<Key, Value>* node, size_t hash, unordered_hash_node<Key, Value>** buckets, size_t nbuckets) {
 		size_t bucket = hash & (nbuckets - 1);
@@ -0,0 +1,198 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TINYSTL_HUGEPAGE_ALLOCATOR_H
+#define TINYSTL_HUGEPAGE_ALLOCATOR_H
+
+#include <TINYSTL/allocator.h>
+#include <TINYSTL/stddef.h>
+
+#ifndef TINYSTL_HUGEPAGE_SIZE
+#	define TINYSTL_HUGEPAGE_SIZE (2 * 1024 * 1024)
+#endif
+
+namespace tinystl {
+
+	// Serves blocks of TINYSTL_HUGEPAGE_SIZE and up from their own
+	// huge-page-aligned mapping advised with MADV_HUGEPAGE, so scans over
+	// large buffers take fewer TLB misses. Smaller blocks come from
+	// tinystl::allocator. Shrinking a mapped block unmaps its tail, so
+	// shrink_to_fit hands the memory back to the OS. Growing one extends it
+	// in place or moves its pages to a fresh aligned mapping.
+	//
+	// On platforms without mremap every block comes from tinystl::allocator.
+	struct hugepage_allocator {
+		static void* static_allocate(size_t bytes);
+		static void* static_allocate(size_t bytes, size_t alignment);
+		static void* static_allocate_at_least(size_t bytes, size_t* actual);
+		static void* static_reallocate(void* ptr, size_t oldbytes, size_t newbytes);
+		static void static_deallocate(void* ptr, size_t bytes);
+		static void static_deallocate(void* ptr, size_t bytes, size_t alignment);
+	};
+
+#if TINYSTL_ALLOCATOR_MREMAP
+	static inline size_t hugepage_round(size_t bytes) {
+		return (bytes + TINYSTL_HUGEPAGE_SIZE - 1) & ~((size_t)TINYSTL_HUGEPAGE_SIZE - 1);
+	}
+
+	static inline void hugepage_advise(void* ptr, size_t bytes) {
+#	if defined(MADV_HUGEPAGE)
+		madvise(ptr, bytes, MADV_HUGEPAGE);
+#	else
+		(void)ptr, (void)bytes;
+#	endif
+	}
+
+	// Maps size bytes (a multiple of the huge page size) starting on a huge
+	// page boundary: over-map, then trim both ends
+	static inline char* hugepage_map(size_t size) {
+		char* map = (char*)mmap(0, size + TINYSTL_HUGEPAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (map == (char*)MAP_FAILED)
+			return 0;
+
+		char* ptr = (char*)(((size_t)map + TINYSTL_HUGEPAGE_SIZE - 1) & ~((size_t)TINYSTL_HUGEPAGE_SIZE - 1));
+		if (ptr != map)
+			munmap(map, (size_t)(ptr - map));
+		if (ptr + size != map + size + TINYSTL_HUGEPAGE_SIZE)
+			munmap(ptr + size, (size_t)(map + size + TINYSTL_HUGEPAGE_SIZE - (ptr + size)));
+
+		return ptr;
+	}
+
+	inline void* hugepage_allocator::static_allocate(size_t bytes) {
+		if (bytes < TINYSTL_HUGEPAGE_SIZE)
+			return allocator::static_allocate(bytes);
+
+		const size_t size = hugepage_round(bytes);
+		char* ptr = hugepage_map(size);
+		if (ptr)
+			hugepage_advise(ptr, size);
+		return ptr;
+	}
+
+	inline void* hugepage_allocator::static_allocate(size_t bytes, size_t alignment) {
+		if (bytes < TINYSTL_HUGEPAGE_SIZE || alignment > TINYSTL_HUGEPAGE_SIZE)
+			return allocator::static_allocate(bytes, alignment);
+		return static_allocate(bytes);
+	}
+
+	inline void* hugepage_allocator::static_allocate_at_least(size_t bytes, size_t* actual) {
+		if (bytes >= TINYSTL_HUGEPAGE_SIZE) {
+			*actual = hugepage_round(bytes);
+			return static_allocate(bytes);
+		}
+
+		// stay below the huge page size so deallocation takes the malloc path
+		size_t rounded = (bytes + c_allocator_alignment - 1) & ~(c_allocator_alignment - 1);
+		if (rounded >= TINYSTL_HUGEPAGE_SIZE)
+			rounded = bytes;
+		*actual = rounded;
+		return allocator::static_allocate(rounded);
+	}
+
+	inline void* hugepage_allocator::static_reallocate(void* ptr, size_t oldbytes, size_t newbytes) {
+		if (oldbytes < TINYSTL_HUGEPAGE_SIZE && newbytes < TINYSTL_HUGEPAGE_SIZE)
+			return allocator::static_reallocate(ptr, oldbytes, newbytes);
+		if (oldbytes < TINYSTL_HUGEPAGE_SIZE || newbytes < TINYSTL_HUGEPAGE_SIZE)
+			return 0;
+
+		const size_t oldsize = hugepage_round(oldbytes);
+		const size_t newsize = hugepage_round(newbytes);
+		if (newsize <= oldsize) {
+			if (newsize != oldsize)
+				munmap((char*)ptr + newsize, oldsize - newsize);
+			return ptr;
+		}
+
+		// grow in place when the address space after the block is free
+		if (mremap(ptr, oldsize, newsize, 0) != MAP_FAILED) {
+			hugepage_advise(ptr, newsize);
+			return ptr;
+		}
+
+#	if defined(MREMAP_FIXED)
+		// otherwise MREMAP_MAYMOVE alone may pick a destination that is not
+		// huge page aligned; reserve an aligned one and move the pages there
+		// without copying them
+		char* dest = hugepage_map(newsize);
+		if (!dest)
+			return 0;
+
+		void* newptr = mremap(ptr, oldsize, newsize, MREMAP_MAYMOVE | MREMAP_FIXED, dest);
+		if (newptr == MAP_FAILED) {
+			munmap(dest, newsize);
+			return 0;
+		}
+
+		hugepage_advise(newptr, newsize);
+		return newptr;
+#	else
+		// the container falls back to allocate, move and deallocate
+		return 0;
+#	endif
+	}
+
+	inline void hugepage_allocator::static_deallocate(void* ptr, size_t bytes) {
+		if (bytes < TINYSTL_HUGEPAGE_SIZE)
+			allocator::static_deallocate(ptr, bytes);
+		else
+			munmap(ptr, hugepage_round(bytes));
+	}
+
+	inline void hugepage_allocator::static_deallocate(void* ptr, size_t bytes, size_t alignment) {
+		if (bytes < TINYSTL_HUGEPAGE_SIZE || alignment > TINYSTL_HUGEPAGE_SIZE)
+			allocator::static_deallocate(ptr, bytes, alignment);
+		else
+			munmap(ptr, hugepage_round(bytes));
+	}
+#else
+	inline void* hugepage_allocator::static_allocate(size_t bytes) {
+		return allocator::static_allocate(bytes);
+	}
+
+	inline void* hugepage_allocator::static_allocate(size_t bytes, size_t alignment) {
+		return allocator::static_allocate(bytes, alignment);
+	}
+
+	inline void* hugepage_allocator::static_allocate_at_least(size_t bytes, size_t* actual) {
+		return allocator::static_allocate_at_least(bytes, actual);
+	}
+
+	inline void* hugepage_allocator::static_reallocate(void* ptr, size_t oldbytes, size_t newbytes) {
+		return allocator::static_reallocate(ptr, oldbytes, newbytes);
+	}
+
+	inline void hugepage_allocator::static_deallocate(void* ptr, size_t bytes) {
+		allocator::static_deallocate(ptr, bytes);
+	}
+
+	inline void hugepage_allocator::static_deallocate(void* ptr, size_t bytes, size_t alignment) {
+		allocator::static_deallocate(ptr, bytes, alignment);
+	}
+#endif
+}
+
+#endif
@@ -0,0 +1,245 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TINYSTL_MPMC_QUEUE_H
+#define TINYSTL_MPMC_QUEUE_H
+
+#include <TINYSTL/allocator.h>
+#include <TINYSTL/atomic.h>
+#include <TINYSTL/new.h>
+#include <TINYSTL/stddef.h>
+#include <TINYSTL/traits.h>
+
+namespace tinystl {
+
+	template<typename T>
+	struct mpmc_queue_slot {
+		size_t sequence;
+		alignas(T) char value[sizeof(T)];
+	};
+
+	// Bounded lock-free queue for any number of producer and consumer
+	// threads. Capacity is rounded up to a power of two.
+	//
+	// Every slot carries a sequence number telling which lap of the ring it
+	// is ready for: a producer claiming position pos waits for sequence ==
+	// pos, a consumer for sequence == pos + 1. Producers and consumers only
+	// contend on their own index, each kept on its own cache line.
+	template<typename T, typename Alloc = TINYSTL_ALLOCATOR>
+	class mpmc_queue {
+	public:
+		explicit mpmc_queue(size_t capacity);
+		mpmc_queue(size_t capacity, const Alloc& alloc);
+		~mpmc_queue();
+
+		const Alloc& get_allocator() const;
+
+		size_t capacity() const;
+
+		// Approximate while other threads are pushing or popping
+		size_t size() const;
+		bool empty() const;
+
+		// These fail and leave the argument untouched when the queue is full
+		bool push(const T& t);
+		bool push(T&& t);
+
+		template<typename... Args>
+		bool emplace(Args&&... args);
+
+		// These fail when the queue is empty
+		bool pop(T& out);
+		bool pop();
+
+	private:
+		mpmc_queue(const mpmc_queue&);
+		mpmc_queue& operator=(const mpmc_queue&);
+
+		typedef mpmc_queue_slot<T> slot;
+
+		void init(size_t capacity);
+		slot* claim_push();
+		slot* claim_pop();
+
+		struct storage : Alloc {
+			storage() {}
+			explicit storage(const Alloc& alloc) : Alloc(alloc) {}
+
+			slot* slots;
+			size_t mask;
+		};
+
+		storage m_storage;
+
+		alignas(TINYSTL_CACHE_LINE_SIZE) size_t m_enqueue;
+		alignas(TINYSTL_CACHE_LINE_SIZE) size_t m_dequeue;
+	};
+
+	template<typename T, typename Alloc>
+	inline mpmc_queue<T, Alloc>::mpmc_queue(size_t capacity) {
+		init(capacity);
+	}
+
+	template<typename T, typename Alloc>
+	inline mpmc_queue<T, Alloc>::mpmc_queue(size_t capacity, const Alloc& alloc)
+		: m_storage(alloc)
+	{
+		init(capacity);
+	}
+
+	template<typename T, typename Alloc>
+	inline void mpmc_queue<T, Alloc>::init(size_t capacity) {
+		size_t size = 2;
+		while (size < capacity)
+			size *= 2;
+
+		m_storage.slots = (slot*)allocator_allocate(static_cast<Alloc&>(m_storage), sizeof(slot) * size, alignof(slot));
+		m_storage.mask = size - 1;
+		for (size_t ii = 0; ii != size; ++ii)
+			m_storage.slots[ii].sequence = ii;
+		m_enqueue = m_dequeue = 0;
+	}
+
+	template<typename T, typename Alloc>
+	inline mpmc_queue<T, Alloc>::~mpmc_queue() {
+		for (size_t it = m_dequeue; it != m_enqueue; ++it)
+			((T*)m_storage.slots[it & m_storage.mask].value)->~T();
+		allocator_deallocate(static_cast<Alloc&>(m_storage), m_storage.slots, sizeof(slot) * (m_storage.mask + 1), alignof(slot));
+	}
+
+	template<typename T, typename Alloc>
+	inline const Alloc& mpmc_queue<T, Alloc>::get_allocator() const {
+		return m_storage;
+	}
+
+	template<typename T, typename Alloc>
+	inline size_t mpmc_queue<T, Alloc>::capacity() const {
+		return m_storage.mask + 1;
+	}
+
+	template<typename T, typename Alloc>
+	inline size_t mpmc_queue<T, Alloc>::size() const {
+		const size_t dequeue = atomic_load_relaxed(&m_dequeue);
+		const size_t enqueue = atomic_load_relaxed(&m_enqueue);
+		return (enqueue > dequeue) ? enqueue - dequeue : 0;
+	}
+
+	template<typename T, typename Alloc>
+	inline bool mpmc_queue<T, Alloc>::empty() const {
+		return size() == 0;
+	}
+
+	// Reserves the slot at the enqueue position, or returns 0 when the slot
+	// there still holds an element from the previous lap
+	template<typename T, typename Alloc>
+	inline typename mpmc_queue<T, Alloc>::slot* mpmc_queue<T, Alloc>::claim_push() {
+		size_t pos = atomic_load_relaxed(&m_enqueue);
+		for (;;) {
+			slot* s = m_storage.slots + (pos & m_storage.mask);
+			const ptrdiff_t diff = (ptrdiff_t)(atomic_load_acquire(&s->sequence) - pos);
+			if (diff == 0) {
+				if (atomic_compare_exchange(&m_enqueue, &pos, pos + 1))
+					return s;
+			} else if (diff < 0) {
+				return 0;
+			} else {
+				pos = atomic_load_relaxed(&m_enqueue);
+			}
+		}
+	}
+
+	template<typename T, typename Alloc>
+	inline typename mpmc_queue<T, Alloc>::slot* mpmc_queue<T, Alloc>::claim_pop() {
+		size_t pos = atomic_load_relaxed(&m_dequeue);
+		for (;;) {
+			slot* s = m_storage.slots + (pos & m_storage.mask);
+			const ptrdiff_t diff = (ptrdiff_t)(atomic_load_acquire(&s->sequence) - (pos + 1));
+			if (diff == 0) {
+				if (atomic_compare_exchange(&m_dequeue, &pos, pos + 1))
+					return s;
+			} else if (diff < 0) {
+				return 0;
+			} else {
+				pos = atomic_load_relaxed(&m_dequeue);
+			}
+		}
+	}
+
+	template<typename T, typename Alloc>
+	inline bool mpmc_queue<T, Alloc>::push(const T& t) {
+		slot* s = claim_push();
+		if (!s)
+			return false;
+
+		new(placeholder(), s->value) T(t);
+		atomic_store_release(&s->sequence, s->sequence + 1);
+		return true;
+	}
+
+	template<typename T, typename Alloc>
+	inline bool mpmc_queue<T, Alloc>::push(T&& t) {
+		return emplace(static_cast<T&&>(t));
+	}
+
+	template<typename T, typename Alloc>
+	template<typename... Args>
+	inline bool mpmc_queue<T, Alloc>::emplace(Args&&... args) {
+		slot* s = claim_push();
+		if (!s)
+			return false;
+
+		new(placeholder(), s->value) T(static_cast<Args&&>(args)...);
+		atomic_store_release(&s->sequence, s->sequence + 1);
+		return true;
+	}
+
+	// the slot is handed back for the next lap: pos + capacity
+	template<typename T, typename Alloc>
+	inline bool mpmc_queue<T, Alloc>::pop(T& out) {
+		slot* s = claim_pop();
+		if (!s)
+			return false;
+
+		T* value = (T*)s->value;
+		move(out, *value);
+		value->~T();
+		atomic_store_release(&s->sequence, s->sequence + m_storage.mask);
+		return true;
+	}
+
+	template<typename T, typename Alloc>
+	inline bool mpmc_queue<T, Alloc>::pop() {
+		slot* s = claim_pop();
+		if (!s)
+			return false;
+
+		((T*)s->value)->~T();
+		atomic_store_release(&s->sequence, s->sequence + m_storage.mask);
+		return true;
+	}
+}
+
+#endif
@@ -0,0 +1,412 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TINYSTL_RING_BUFFER_H
+#define TINYSTL_RING_BUFFER_H
+
+#include <TINYSTL/allocator.h>
+#include <TINYSTL/buffer.h>
+#include <TINYSTL/new.h>
+#include <TINYSTL/stddef.h>
+#include <TINYSTL/traits.h>
+
+namespace tinystl {
+
+	template<typename T>
+	struct ring_span {
+		size_t size() const { return (size_t)(last - first); }
+
+		T* first;
+		T* last;
+	};
+
+	template<typename T, typename Alloc = TINYSTL_ALLOCATOR>
+	struct ring_storage : Alloc {
+		ring_storage() {}
+		explicit ring_storage(const Alloc& alloc) : Alloc(alloc) {}
+
+		T* data;
+		size_t capacity;
+		size_t head;
+		size_t size;
+	};
+
+	template<typename T, typename Alloc>
+	static inline void ring_storage_init(ring_storage<T, Alloc>* r) {
+		r->data = 0;
+		r->capacity = r->head = r->size = 0;
+	}
+
+	template<typename T, typename Alloc>
+	static inline T* ring_storage_slot(const ring_storage<T, Alloc>* r, size_t idx) {
+		return r->data + ((r->head + idx) & (r->capacity - 1));
+	}
+
+	template<typename T, typename Alloc>
+	static inline void ring_storage_destroy(ring_storage<T, Alloc>* r) {
+		const size_t tail = r->capacity - r->head;
+		if (r->size > tail) {
+			buffer_destroy_range(r->data + r->head, r->data + r->capacity);
+			buffer_destroy_range(r->data, r->data + (r->size - tail));
+		} else {
+			buffer_destroy_range(r->data + r->head, r->data + r->head + r->size);
+		}
+		r->size = 0;
+	}
+
+	template<typename T, typename Alloc>
+	static inline T* ring_storage_reallocate_traits(ring_storage<T, Alloc>*, size_t, relocatable_traits<T, false>) {
+		return 0;
+	}
+
+	template<typename T, typename Alloc>
+	static inline T* ring_storage_reallocate_traits(ring_storage<T, Alloc>* r, size_t capacity, relocatable_traits<T, true>) {
+		return (T*)allocator_reallocate(static_cast<Alloc&>(*r), r->data, sizeof(T) * r->capacity, sizeof(T) * capacity, alignof(T));
+	}
+
+	// Grows to a power of two capacity. Elements keep their order; when the
+	// block is resized in place only the wrapped part moves, to just past
+	// the old end.
+	template<typename T, typename Alloc>
+	static inline void ring_storage_reserve(ring_storage<T, Alloc>* r, size_t capacity) {
+		if (capacity <= r->capacity)
+			return;
+
+		size_t newcapacity = r->capacity ? r->capacity : 8;
+		while (newcapacity < capacity)
+			newcapacity *= 2;
+
+		const size_t tail = r->capacity - r->head;
+		T* newdata = r->data ? ring_storage_reallocate_traits(r, newcapacity, relocatable_traits<T>()) : 0;
+		if (newdata) {
+			if (r->size > tail)
+				buffer_move_urange(newdata + r->capacity, newdata, newdata + (r->size - tail));
+		} else {
+			newdata = (T*)allocator_allocate(static_cast<Alloc&>(*r), sizeof(T) * newcapacity, alignof(T));
+			if (r->size > tail) {
+				buffer_move_urange(newdata, r->data + r->head, r->data + r->capacity);
+				buffer_move_urange(newdata + tail, r->data, r->data + (r->size - tail));
+			} else {
+				buffer_move_urange(newdata, r->data + r->head, r->data + r->head + r->size);
+			}
+			allocator_deallocate(static_cast<Alloc&>(*r), r->data, sizeof(T) * r->capacity, alignof(T));
+			r->head = 0;
+		}
+
+		r->data = newdata;
+		r->capacity = newcapacity;
+	}
+
+	// A FIFO queue over a power of two sized block. The live elements are
+	// at most two contiguous runs, exposed through first_span() and
+	// second_span() so they can be copied out or handed to writev directly.
+	template<typename T, typename Alloc = TINYSTL_ALLOCATOR>
+	class ring_buffer {
+	public:
+		ring_buffer();
+		explicit ring_buffer(const Alloc& alloc);
+		ring_buffer(const ring_buffer& other);
+		ring_buffer(ring_buffer&& other);
+		~ring_buffer();
+
+		ring_buffer& operator=(const ring_buffer& other);
+		ring_buffer& operator=(ring_buffer&& other);
+
+		const Alloc& get_allocator() const;
+
+		size_t size() const;
+		size_t capacity() const;
+		bool empty() const;
+
+		T& operator[](size_t idx);
+		const T& operator[](size_t idx) const;
+
+		const T& front() const;
+		T& front();
+		const T& back() const;
+		T& back();
+
+		void clear();
+		void reserve(size_t capacity);
+
+		void push_back(const T& t);
+		void push_back(T&& t);
+		void push_back(const T* first, const T* last);
+
+		template<typename... Args>
+		void emplace_back(Args&&... args);
+
+		void pop_front();
+		void pop_front(size_t count);
+		size_t pop_front(T* first, T* last);
+
+		ring_span<T> first_span();
+		ring_span<const T> first_span() const;
+		ring_span<T> second_span();
+		ring_span<const T> second_span() const;
+
+		void swap(ring_buffer& other);
+
+		typedef T value_type;
+
+	private:
+		ring_storage<T, Alloc> m_storage;
+	};
+
+	template<typename T, typename Alloc>
+	struct is_trivially_relocatable<ring_buffer<T, Alloc> > {
+		static const bool value = is_trivially_relocatable<Alloc>::value;
+	};
+
+	template<typename T, typename Alloc>
+	inline ring_buffer<T, Alloc>::ring_buffer() {
+		ring_storage_init(&m_storage);
+	}
+
+	template<typename T, typename Alloc>
+	inline ring_buffer<T, Alloc>::ring_buffer(const Alloc& alloc)
+		: m_storage(alloc)
+	{
+		ring_storage_init(&m_storage);
+	}
+
+	template<typename T, typename Alloc>
+	inline ring_buffer<T, Alloc>::ring_buffer(const ring_buffer& other)
+		: m_storage(other.get_allocator())
+	{
+		ring_storage_init(&m_storage);
+		ring_storage_reserve(&m_storage, other.size());
+
+		const ring_span<const T> first = other.first_span(), second = other.second_span();
+		push_back(first.first, first.last);
+		push_back(second.first, second.last);
+	}
+
+	template<typename T, typename Alloc>
+	inline ring_buffer<T, Alloc>::ring_buffer(ring_buffer&& other)
+		: m_storage(other.m_storage)
+	{
+		ring_storage_init(&other.m_storage);
+	}
+
+	template<typename T, typename Alloc>
+	inline ring_buffer<T, Alloc>::~ring_buffer() {
+		ring_storage_destroy(&m_storage);
+		allocator_deallocate(static_cast<Alloc&>(m_storage), m_storage.data, sizeof(T) * m_storage.capacity, alignof(T));
+	}
+
+	template<typename T, typename Alloc>
+	inline ring_buffer<T, Alloc>& ring_buffer<T, Alloc>::operator=(const ring_buffer& other) {
+		ring_buffer(other).swap(*this);
+		return *this;
+	}
+
+	template<typename T, typename Alloc>
+	inline ring_buffer<T, Alloc>& ring_buffer<T, Alloc>::operator=(ring_buffer&& other) {
+		ring_storage_destroy(&m_storage);
+		allocator_deallocate(static_cast<Alloc&>(m_storage), m_storage.data, sizeof(T) * m_storage.capacity, alignof(T));
+		m_storage = other.m_storage;
+		ring_storage_init(&other.m_storage);
+		return *this;
+	}
+
+	template<typename T, typename Alloc>
+	inline const Alloc& ring_buffer<T, Alloc>::get_allocator() const {
+		return m_storage;
+	}
+
+	template<typename T, typename Alloc>
+	inline size_t ring_buffer<T, Alloc>::size() const {
+		return m_storage.size;
+	}
+
+	template<typename T, typename Alloc>
+	inline size_t ring_buffer<T, Alloc>::capacity() const {
+		return m_storage.capacity;
+	}
+
+	template<typename T, typename Alloc>
+	inline bool ring_buffer<T, Alloc>::empty() const {
+		return m_storage.size == 0;
+	}
+
+	template<typename T, typename Alloc>
+	inline T& ring_buffer<T, Alloc>::operator[](size_t idx) {
+		return *ring_storage_slot(&m_storage, idx);
+	}
+
+	template<typename T, typename Alloc>
+	inline const T& ring_buffer<T, Alloc>::operator[](size_t idx) const {
+		return *ring_storage_slot(&m_storage, idx);
+	}
+
+	template<typename T, typename Alloc>
+	inline const T& ring_buffer<T, Alloc>::front() const {
+		return m_storage.data[m_storage.head];
+	}
+
+	template<typename T, typename Alloc>
+	inline T& ring_buffer<T, Alloc>::front() {
+		return m_storage.data[m_storage.head];
+	}
+
+	template<typename T, typename Alloc>
+	inline const T& ring_buffer<T, Alloc>::back() const {
+		return *ring_storage_slot(&m_storage, m_storage.size - 1);
+	}
+
+	template<typename T, typename Alloc>
+	inline T& ring_buffer<T, Alloc>::back() {
+		return *ring_storage_slot(&m_storage, m_storage.size - 1);
+	}
+
+	template<typename T, typename Alloc>
+	inline void ring_buffer<T, Alloc>::clear() {
+		ring_storage_destroy(&m_storage);
+		m_storage.head = 0;
+	}
+
+	template<typename T, typename Alloc>
+	inline void ring_buffer<T, Alloc>::reserve(size_t capacity) {
+		ring_storage_reserve(&m_storage, capacity);
+	}
+
+	template<typename T, typename Alloc>
+	inline void ring_buffer<T, Alloc>::push_back(const T& t) {
+		if (m_storage.size == m_storage.capacity) {
+			// t may be one of our elements, which can move when the block grows
+			T value(t);
+			ring_storage_reserve(&m_storage, m_storage.size + 1);
+			new(placeholder(), ring_storage_slot(&m_storage, m_storage.size)) T(static_cast<T&&>(value));
+		} else {
+			new(placeholder(), ring_storage_slot(&m_storage, m_storage.size)) T(t);
+		}
+		++m_storage.size;
+	}
+
+	template<typename T, typename Alloc>
+	inline void ring_buffer<T, Alloc>::push_back(T&& t) {
+		emplace_back(static_cast<T&&>(t));
+	}
+
+	template<typename T, typename Alloc>
+	inline void ring_buffer<T, Alloc>::push_back(const T* first, const T* last) {
+		const size_t count = (size_t)(last - first);
+		ring_storage_reserve(&m_storage, m_storage.size + count);
+
+		// fill the free run up to the end of the block, then wrap
+		T* where = ring_storage_slot(&m_storage, m_storage.size);
+		const size_t room = (size_t)(m_storage.data + m_storage.capacity - where);
+		const T* split = first + ((count < room) ? count : room);
+		buffer_copy_urange(where, first, split);
+		buffer_copy_urange(m_storage.data, split, last);
+		m_storage.size += count;
+	}
+
+	template<typename T, typename Alloc>
+	template<typename... Args>
+	inline void ring_buffer<T, Alloc>::emplace_back(Args&&... args) {
+		if (m_storage.size == m_storage.capacity) {
+			T value(static_cast<Args&&>(args)...);
+			ring_storage_reserve(&m_storage, m_storage.size + 1);
+			new(placeholder(), ring_storage_slot(&m_storage, m_storage.size)) T(static_cast<T&&>(value));
+		} else {
+			new(placeholder(), ring_storage_slot(&m_storage, m_storage.size)) T(static_cast<Args&&>(args)...);
+		}
+		++m_storage.size;
+	}
+
+	template<typename T, typename Alloc>
+	inline void ring_buffer<T, Alloc>::pop_front() {
+		m_storage.data[m_storage.head].~T();
+		m_storage.head = (m_storage.head + 1) & (m_storage.capacity - 1);
+		--m_storage.size;
+	}
+
+	template<typename T, typename Alloc>
+	inline void ring_buffer<T, Alloc>::pop_front(size_t count) {
+		const ring_span<T> first = first_span();
+		if (count > first.size()) {
+			buffer_destroy_range(first.first, first.last);
+			buffer_destroy_range(m_storage.data, m_storage.data + (count - first.size()));
+		} else {
+			buffer_destroy_range(first.first, first.first + count);
+		}
+		m_storage.head = (m_storage.head + count) & (m_storage.capacity - 1);
+		m_storage.size -= count;
+	}
+
+	// Moves up to last - first elements into [first, last) and removes them;
+	// returns the number moved
+	template<typename T, typename Alloc>
+	inline size_t ring_buffer<T, Alloc>::pop_front(T* first, T* last) {
+		size_t count = (size_t)(last - first);
+		if (count > m_storage.size)
+			count = m_storage.size;
+
+		for (size_t ii = 0; ii != count; ++ii)
+			move(first[ii], *ring_storage_slot(&m_storage, ii));
+		pop_front(count);
+		return count;
+	}
+
+	template<typename T, typename Alloc>
+	inline ring_span<T> ring_buffer<T, Alloc>::first_span() {
+		const size_t tail = m_storage.capacity - m_storage.head;
+		const ring_span<T> span = { m_storage.data + m_storage.head, m_storage.data + m_storage.head + ((m_storage.size < tail) ? m_storage.size : tail) };
+		return span;
+	}
+
+	template<typename T, typename Alloc>
+	inline ring_span<const T> ring_buffer<T, Alloc>::first_span() const {
+		const size_t tail = m_storage.capacity - m_storage.head;
+		const ring_span<const T> span = { m_storage.data + m_storage.head, m_storage.data + m_storage.head + ((m_storage.size < tail) ? m_storage.size : tail) };
+		return span;
+	}
+
+	template<typename T, typename Alloc>
+	inline ring_span<T> ring_buffer<T, Alloc>::second_span() {
+		const size_t tail = m_storage.capacity - m_storage.head;
+		const ring_span<T> span = { m_storage.data, m_storage.data + ((m_storage.size > tail) ? m_storage.size - tail : 0) };
+		return span;
+	}
+
+	template<typename T, typename Alloc>
+	inline ring_span<const T> ring_buffer<T, Alloc>::second_span() const {
+		const size_t tail = m_storage.capacity - m_storage.head;
+		const ring_span<const T> span = { m_storage.data, m_storage.data + ((m_storage.size > tail) ? m_storage.size - tail : 0) };
+		return span;
+	}
+
+	template<typename T, typename Alloc>
+	inline void ring_buffer<T, Alloc>::swap(ring_buffer& other) {
+		const ring_storage<T, Alloc> tstorage = m_storage;
+		m_storage = other.m_storage;
+		other.m_storage = tstorage;
+	}
+}
+
+#endif
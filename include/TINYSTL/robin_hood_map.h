@@ -0,0 +1,562 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TINYSTL_ROBIN_HOOD_MAP_H
+#define TINYSTL_ROBIN_HOOD_MAP_H
+
+#include <TINYSTL/allocator.h>
+#include <TINYSTL/buffer.h>
+#include <TINYSTL/hash.h>
+#include <TINYSTL/hash_base.h>
+#include <TINYSTL/new.h>
+#include <TINYSTL/stddef.h>
+#include <TINYSTL/traits.h>
+#include <string.h>
+
+namespace tinystl {
+
+	template<typename Slot>
+	struct robin_hood_iterator {
+		Slot* operator->() const;
+		Slot& operator*() const;
+
+		const unsigned char* distance;
+		Slot* slot;
+	};
+
+	template<typename Slot>
+	struct robin_hood_iterator<const Slot> {
+		robin_hood_iterator() {}
+		robin_hood_iterator(robin_hood_iterator<Slot> other)
+			: distance(other.distance)
+			, slot(other.slot)
+		{
+		}
+
+		const Slot* operator->() const;
+		const Slot& operator*() const;
+
+		const unsigned char* distance;
+		const Slot* slot;
+	};
+
+	template<typename LSlot, typename RSlot>
+	static inline bool operator==(const robin_hood_iterator<LSlot>& lhs, const robin_hood_iterator<RSlot>& rhs) {
+		return lhs.slot == rhs.slot;
+	}
+
+	template<typename LSlot, typename RSlot>
+	static inline bool operator!=(const robin_hood_iterator<LSlot>& lhs, const robin_hood_iterator<RSlot>& rhs) {
+		return lhs.slot != rhs.slot;
+	}
+
+	// skips empty slots; a nonzero byte past the last slot stops the walk
+	template<typename Slot>
+	static inline void operator++(robin_hood_iterator<Slot>& lhs) {
+		do {
+			++lhs.distance;
+			++lhs.slot;
+		} while (!*lhs.distance);
+	}
+
+	template<typename Slot>
+	inline Slot* robin_hood_iterator<Slot>::operator->() const {
+		return slot;
+	}
+
+	template<typename Slot>
+	inline Slot& robin_hood_iterator<Slot>::operator*() const {
+		return *slot;
+	}
+
+	template<typename Slot>
+	inline const Slot* robin_hood_iterator<const Slot>::operator->() const {
+		return slot;
+	}
+
+	template<typename Slot>
+	inline const Slot& robin_hood_iterator<const Slot>::operator*() const {
+		return *slot;
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	struct robin_hood_table : Alloc {
+		typedef pair<Key, Value> slot;
+
+		robin_hood_table() {}
+		explicit robin_hood_table(const Alloc& alloc) : Alloc(alloc) {}
+
+		slot* slots;
+		unsigned char* distance;
+		size_t capacity;
+		size_t size;
+	};
+
+	template<typename Key, typename Value, typename Alloc>
+	static inline void robin_hood_init(robin_hood_table<Key, Value, Alloc>* t) {
+		t->slots = 0;
+		t->distance = 0;
+		t->capacity = t->size = 0;
+	}
+
+	// Slots and distance bytes share one block, distances last so the slots
+	// keep their alignment; the byte past the last distance stops iteration
+	template<typename Slot>
+	static inline size_t robin_hood_bytes(size_t capacity) {
+		return (sizeof(Slot) + 1) * capacity + 1;
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	static inline void robin_hood_allocate(robin_hood_table<Key, Value, Alloc>* t, size_t capacity) {
+		typedef typename robin_hood_table<Key, Value, Alloc>::slot slot;
+
+		char* block = (char*)allocator_allocate(static_cast<Alloc&>(*t), robin_hood_bytes<slot>(capacity), alignof(slot));
+		t->slots = (slot*)block;
+		t->distance = (unsigned char*)(block + sizeof(slot) * capacity);
+		t->capacity = capacity;
+		memset(t->distance, 0, capacity);
+		t->distance[capacity] = 1;
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	static inline void robin_hood_deallocate(robin_hood_table<Key, Value, Alloc>* t) {
+		typedef typename robin_hood_table<Key, Value, Alloc>::slot slot;
+
+		if (t->slots)
+			allocator_deallocate(static_cast<Alloc&>(*t), t->slots, robin_hood_bytes<slot>(t->capacity), alignof(slot));
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	static inline void robin_hood_destroy_slots(robin_hood_table<Key, Value, Alloc>* t) {
+		typedef typename robin_hood_table<Key, Value, Alloc>::slot slot;
+
+		for (size_t ii = 0; ii != t->capacity; ++ii) {
+			if (t->distance[ii])
+				t->slots[ii].~slot();
+		}
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	static inline void robin_hood_clear(robin_hood_table<Key, Value, Alloc>* t) {
+		robin_hood_destroy_slots(t);
+		if (t->capacity)
+			memset(t->distance, 0, t->capacity);
+		t->size = 0;
+	}
+
+	// Returns the index holding key, or capacity if it is not present
+	template<typename Key, typename Value, typename Alloc>
+	static inline size_t robin_hood_find(const robin_hood_table<Key, Value, Alloc>* t, const Key& key, size_t keyhash) {
+		if (!t->size)
+			return t->capacity;
+
+		const size_t mask = t->capacity - 1;
+		size_t index = keyhash & mask;
+		for (unsigned distance = 1; distance <= t->distance[index]; ++distance) {
+			if (t->distance[index] == distance && t->slots[index].first == key)
+				return index;
+			index = (index + 1) & mask;
+		}
+
+		return t->capacity;
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	static inline void robin_hood_resize(robin_hood_table<Key, Value, Alloc>* t, size_t capacity);
+
+	// Makes room for a key known to be absent and returns its slot; the
+	// caller constructs the element there
+	template<typename Key, typename Value, typename Alloc>
+	static inline size_t robin_hood_prepare_insert(robin_hood_table<Key, Value, Alloc>* t, size_t keyhash) {
+		if (t->size + 1 > t->capacity - t->capacity / 10)
+			robin_hood_resize(t, t->capacity ? t->capacity * 2 : 16);
+
+		for (;;) {
+			const size_t mask = t->capacity - 1;
+			unsigned char* distance = t->distance;
+
+			// walk past every entry at least as far from home as we are
+			size_t index = keyhash & mask;
+			unsigned probe = 1;
+			while (distance[index] >= probe) {
+				++probe;
+				index = (index + 1) & mask;
+			}
+
+			// the entries from there to the next empty slot each move one
+			// further from home
+			size_t last = index;
+			bool overflow = (probe > 255);
+			for (; distance[last]; last = (last + 1) & mask)
+				overflow |= (distance[last] == 255);
+
+			if (overflow) {
+				robin_hood_resize(t, t->capacity * 2);
+				continue;
+			}
+
+			for (size_t slot = last; slot != index; ) {
+				const size_t prev = (slot - 1) & mask;
+				buffer_move_urange(t->slots + slot, t->slots + prev, t->slots + prev + 1);
+				distance[slot] = (unsigned char)(distance[prev] + 1);
+				slot = prev;
+			}
+
+			distance[index] = (unsigned char)probe;
+			++t->size;
+			return index;
+		}
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	static inline void robin_hood_erase(robin_hood_table<Key, Value, Alloc>* t, size_t index) {
+		typedef typename robin_hood_table<Key, Value, Alloc>::slot slot;
+
+		const size_t mask = t->capacity - 1;
+		unsigned char* distance = t->distance;
+
+		t->slots[index].~slot();
+		for (size_t next = (index + 1) & mask; distance[next] > 1; next = (next + 1) & mask) {
+			buffer_move_urange(t->slots + index, t->slots + next, t->slots + next + 1);
+			distance[index] = (unsigned char)(distance[next] - 1);
+			index = next;
+		}
+
+		distance[index] = 0;
+		--t->size;
+	}
+
+	// Entries are reinserted through robin_hood_prepare_insert, so the new
+	// table may itself grow should a run overflow
+	template<typename Key, typename Value, typename Alloc>
+	static inline void robin_hood_resize(robin_hood_table<Key, Value, Alloc>* t, size_t capacity) {
+		typedef typename robin_hood_table<Key, Value, Alloc>::slot slot;
+
+		const robin_hood_table<Key, Value, Alloc> old = *t;
+
+		robin_hood_allocate(t, capacity);
+		t->size = 0;
+		for (size_t ii = 0; ii != old.capacity; ++ii) {
+			if (!old.distance[ii])
+				continue;
+
+			const size_t index = robin_hood_prepare_insert(t, hash(old.slots[ii].first));
+			buffer_move_urange(t->slots + index, old.slots + ii, old.slots + ii + 1);
+		}
+
+		if (old.slots)
+			allocator_deallocate(static_cast<Alloc&>(*t), old.slots, robin_hood_bytes<slot>(old.capacity), alignof(slot));
+	}
+
+	// Sizes the table so count elements fit without growing
+	template<typename Key, typename Value, typename Alloc>
+	static inline void robin_hood_reserve(robin_hood_table<Key, Value, Alloc>* t, size_t count) {
+		size_t capacity = 16;
+		while (capacity - capacity / 10 < count)
+			capacity *= 2;
+		if (capacity > t->capacity)
+			robin_hood_resize(t, capacity);
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	static inline void robin_hood_copy(robin_hood_table<Key, Value, Alloc>* t, const robin_hood_table<Key, Value, Alloc>* other) {
+		typedef typename robin_hood_table<Key, Value, Alloc>::slot slot;
+
+		if (!other->capacity)
+			return;
+
+		robin_hood_allocate(t, other->capacity);
+		memcpy(t->distance, other->distance, other->capacity);
+		for (size_t ii = 0; ii != other->capacity; ++ii) {
+			if (other->distance[ii])
+				new(placeholder(), t->slots + ii) slot(other->slots[ii]);
+		}
+		t->size = other->size;
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	static inline void robin_hood_swap(robin_hood_table<Key, Value, Alloc>* t, robin_hood_table<Key, Value, Alloc>* other) {
+		const robin_hood_table<Key, Value, Alloc> tmp = *t;
+		*t = *other;
+		*other = tmp;
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	static inline void robin_hood_move(robin_hood_table<Key, Value, Alloc>* dst, robin_hood_table<Key, Value, Alloc>* src) {
+		*dst = *src;
+		robin_hood_init(src);
+	}
+
+	template<typename Slot, typename Key, typename Value, typename Alloc>
+	static inline robin_hood_iterator<Slot> robin_hood_make_iterator(const robin_hood_table<Key, Value, Alloc>* t, size_t index) {
+		robin_hood_iterator<Slot> it;
+		it.distance = t->distance + index;
+		it.slot = t->slots + index;
+		return it;
+	}
+
+	template<typename Slot, typename Key, typename Value, typename Alloc>
+	static inline robin_hood_iterator<Slot> robin_hood_begin(const robin_hood_table<Key, Value, Alloc>* t) {
+		robin_hood_iterator<Slot> it = robin_hood_make_iterator<Slot>(t, 0);
+		if (t->capacity && !*it.distance)
+			++it;
+		return it;
+	}
+
+	// Linear-probing map using Robin Hood placement: each slot records one
+	// plus its distance from the key's home slot (0 marks it empty), and an
+	// entry never sits behind one that is further from home. Runs stay
+	// sorted by home slot, so a lookup stops at the first entry closer to
+	// home than itself, an insert shifts the rest of its run forward by
+	// one, and an erase shifts the run back instead of leaving a tombstone.
+	// Tables fill to 0.9 before growing.
+	//
+	// Distances are kept in a byte, so a run longer than 255 forces the
+	// table to grow; the hash must spread keys. Inserting or erasing
+	// invalidates iterators and references.
+	template<typename Key, typename Value, typename Alloc = TINYSTL_ALLOCATOR>
+	class robin_hood_map {
+	public:
+		robin_hood_map();
+		explicit robin_hood_map(const Alloc& alloc);
+		robin_hood_map(const robin_hood_map& other);
+		robin_hood_map(robin_hood_map&& other);
+		~robin_hood_map();
+
+		robin_hood_map& operator=(const robin_hood_map& other);
+		robin_hood_map& operator=(robin_hood_map&& other);
+
+		const Alloc& get_allocator() const;
+
+		typedef pair<Key, Value> value_type;
+
+		typedef robin_hood_iterator<const value_type> const_iterator;
+		typedef robin_hood_iterator<value_type> iterator;
+
+		iterator begin();
+		iterator end();
+
+		const_iterator begin() const;
+		const_iterator end() const;
+
+		void clear();
+		bool empty() const;
+		size_t size() const;
+		size_t capacity() const;
+		void reserve(size_t size);
+
+		const_iterator find(const Key& key) const;
+		iterator find(const Key& key);
+		pair<iterator, bool> insert(const pair<Key, Value>& p);
+		pair<iterator, bool> emplace(pair<Key, Value>&& p);
+		void erase(const_iterator where);
+		size_t erase(const Key& key);
+
+		Value& operator[](const Key& key);
+
+		void swap(robin_hood_map& other);
+
+	private:
+		robin_hood_table<Key, Value, Alloc> m_table;
+	};
+
+	template<typename Key, typename Value, typename Alloc>
+	struct is_trivially_relocatable<robin_hood_map<Key, Value, Alloc> > {
+		static const bool value = is_trivially_relocatable<Alloc>::value;
+	};
+
+	template<typename Key, typename Value, typename Alloc>
+	inline robin_hood_map<Key, Value, Alloc>::robin_hood_map() {
+		robin_hood_init(&m_table);
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline robin_hood_map<Key, Value, Alloc>::robin_hood_map(const Alloc& alloc)
+		: m_table(alloc)
+	{
+		robin_hood_init(&m_table);
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline robin_hood_map<Key, Value, Alloc>::robin_hood_map(const robin_hood_map& other)
+		: m_table(other.get_allocator())
+	{
+		robin_hood_init(&m_table);
+		robin_hood_copy(&m_table, &other.m_table);
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline robin_hood_map<Key, Value, Alloc>::robin_hood_map(robin_hood_map&& other)
+		: m_table(other.get_allocator())
+	{
+		robin_hood_move(&m_table, &other.m_table);
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline robin_hood_map<Key, Value, Alloc>::~robin_hood_map() {
+		robin_hood_destroy_slots(&m_table);
+		robin_hood_deallocate(&m_table);
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline robin_hood_map<Key, Value, Alloc>& robin_hood_map<Key, Value, Alloc>::operator=(const robin_hood_map& other) {
+		robin_hood_map(other).swap(*this);
+		return *this;
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline robin_hood_map<Key, Value, Alloc>& robin_hood_map<Key, Value, Alloc>::operator=(robin_hood_map&& other) {
+		robin_hood_map(static_cast<robin_hood_map&&>(other)).swap(*this);
+		return *this;
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline const Alloc& robin_hood_map<Key, Value, Alloc>::get_allocator() const {
+		return m_table;
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline typename robin_hood_map<Key, Value, Alloc>::iterator robin_hood_map<Key, Value, Alloc>::begin() {
+		return robin_hood_begin<value_type>(&m_table);
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline typename robin_hood_map<Key, Value, Alloc>::iterator robin_hood_map<Key, Value, Alloc>::end() {
+		return robin_hood_make_iterator<value_type>(&m_table, m_table.capacity);
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline typename robin_hood_map<Key, Value, Alloc>::const_iterator robin_hood_map<Key, Value, Alloc>::begin() const {
+		return robin_hood_begin<const value_type>(&m_table);
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline typename robin_hood_map<Key, Value, Alloc>::const_iterator robin_hood_map<Key, Value, Alloc>::end() const {
+		return robin_hood_make_iterator<const value_type>(&m_table, m_table.capacity);
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline void robin_hood_map<Key, Value, Alloc>::clear() {
+		robin_hood_clear(&m_table);
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline bool robin_hood_map<Key, Value, Alloc>::empty() const {
+		return m_table.size == 0;
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline size_t robin_hood_map<Key, Value, Alloc>::size() const {
+		return m_table.size;
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline size_t robin_hood_map<Key, Value, Alloc>::capacity() const {
+		return m_table.capacity;
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline void robin_hood_map<Key, Value, Alloc>::reserve(size_t size) {
+		robin_hood_reserve(&m_table, size);
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline typename robin_hood_map<Key, Value, Alloc>::iterator robin_hood_map<Key, Value, Alloc>::find(const Key& key) {
+		return robin_hood_make_iterator<value_type>(&m_table, robin_hood_find(&m_table, key, hash(key)));
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline typename robin_hood_map<Key, Value, Alloc>::const_iterator robin_hood_map<Key, Value, Alloc>::find(const Key& key) const {
+		return robin_hood_make_iterator<const value_type>(&m_table, robin_hood_find(&m_table, key, hash(key)));
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline pair<typename robin_hood_map<Key, Value, Alloc>::iterator, bool> robin_hood_map<Key, Value, Alloc>::insert(const pair<Key, Value>& p) {
+		pair<iterator, bool> result;
+		result.second = false;
+
+		const size_t keyhash = hash(p.first);
+		size_t index = robin_hood_find(&m_table, p.first, keyhash);
+		if (index == m_table.capacity) {
+			index = robin_hood_prepare_insert(&m_table, keyhash);
+			new(placeholder(), m_table.slots + index) value_type(p);
+			result.second = true;
+		}
+
+		result.first = robin_hood_make_iterator<value_type>(&m_table, index);
+		return result;
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline pair<typename robin_hood_map<Key, Value, Alloc>::iterator, bool> robin_hood_map<Key, Value, Alloc>::emplace(pair<Key, Value>&& p) {
+		pair<iterator, bool> result;
+		result.second = false;
+
+		const size_t keyhash = hash(p.first);
+		size_t index = robin_hood_find(&m_table, p.first, keyhash);
+		if (index == m_table.capacity) {
+			index = robin_hood_prepare_insert(&m_table, keyhash);
+			new(placeholder(), m_table.slots + index) value_type(static_cast<Key&&>(p.first), static_cast<Value&&>(p.second));
+			result.second = true;
+		}
+
+		result.first = robin_hood_make_iterator<value_type>(&m_table, index);
+		return result;
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline void robin_hood_map<Key, Value, Alloc>::erase(const_iterator where) {
+		robin_hood_erase(&m_table, (size_t)(where.slot - m_table.slots));
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline size_t robin_hood_map<Key, Value, Alloc>::erase(const Key& key) {
+		const size_t index = robin_hood_find(&m_table, key, hash(key));
+		if (index == m_table.capacity)
+			return 0;
+
+		robin_hood_erase(&m_table, index);
+		return 1;
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline Value& robin_hood_map<Key, Value, Alloc>::operator[](const Key& key) {
+		const size_t keyhash = hash(key);
+		size_t index = robin_hood_find(&m_table, key, keyhash);
+		if (index == m_table.capacity) {
+			index = robin_hood_prepare_insert(&m_table, keyhash);
+			new(placeholder(), m_table.slots + index) value_type(key, Value());
+		}
+
+		return m_table.slots[index].second;
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline void robin_hood_map<Key, Value, Alloc>::swap(robin_hood_map& other) {
+		robin_hood_swap(&m_table, &other.m_table);
+	}
+}
+#endif
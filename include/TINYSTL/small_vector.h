@@ -0,0 +1,201 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TINYSTL_SMALL_VECTOR_H
+#define TINYSTL_SMALL_VECTOR_H
+
+#include <TINYSTL/allocator.h>
+#include <TINYSTL/buffer.h>
+#include <TINYSTL/vector.h>
+
+namespace tinystl {
+
+	// Hands out its own inline storage for blocks of up to N elements and
+	// forwards anything larger to Alloc. Copies start with empty storage,
+	// so a container's allocator never shares it.
+	template<typename T, size_t N, typename Alloc = TINYSTL_ALLOCATOR>
+	struct small_vector_allocator : Alloc {
+		small_vector_allocator();
+		explicit small_vector_allocator(const Alloc& alloc);
+		small_vector_allocator(const small_vector_allocator& other);
+		small_vector_allocator& operator=(const small_vector_allocator& other);
+
+		void* static_allocate(size_t bytes);
+		void* static_allocate(size_t bytes, size_t alignment);
+		void* static_allocate_at_least(size_t bytes, size_t* actual);
+		void* static_reallocate(void* ptr, size_t oldbytes, size_t newbytes);
+		void static_deallocate(void* ptr, size_t bytes);
+		void static_deallocate(void* ptr, size_t bytes, size_t alignment);
+
+		bool is_inline(const void* ptr) const;
+
+		static const size_t c_capacity = N * sizeof(T);
+
+		alignas(T) char m_storage[c_capacity];
+		bool m_used;
+	};
+
+	// The inline storage lives inside the allocator, so its bytes can never be
+	// moved around without fixing up the container's pointers
+	template<typename T, size_t N, typename Alloc>
+	struct is_trivially_relocatable<small_vector_allocator<T, N, Alloc> > {
+		static const bool value = false;
+	};
+
+	// A vector that keeps up to N elements inline before spilling to the heap
+	template<typename T, size_t N, typename Alloc = TINYSTL_ALLOCATOR>
+	using small_vector = vector<T, small_vector_allocator<T, N, Alloc> >;
+
+	template<typename T, size_t N, typename Alloc>
+	inline small_vector_allocator<T, N, Alloc>::small_vector_allocator()
+		: m_used(false)
+	{
+	}
+
+	template<typename T, size_t N, typename Alloc>
+	inline small_vector_allocator<T, N, Alloc>::small_vector_allocator(const Alloc& alloc)
+		: Alloc(alloc)
+		, m_used(false)
+	{
+	}
+
+	template<typename T, size_t N, typename Alloc>
+	inline small_vector_allocator<T, N, Alloc>::small_vector_allocator(const small_vector_allocator& other)
+		: Alloc(other)
+		, m_used(false)
+	{
+	}
+
+	template<typename T, size_t N, typename Alloc>
+	inline small_vector_allocator<T, N, Alloc>& small_vector_allocator<T, N, Alloc>::operator=(const small_vector_allocator& other) {
+		static_cast<Alloc&>(*this) = other;
+		return *this;
+	}
+
+	template<typename T, size_t N, typename Alloc>
+	inline bool small_vector_allocator<T, N, Alloc>::is_inline(const void* ptr) const {
+		return ptr == m_storage;
+	}
+
+	template<typename T, size_t N, typename Alloc>
+	inline void* small_vector_allocator<T, N, Alloc>::static_allocate(size_t bytes) {
+		if (bytes <= c_capacity && !m_used) {
+			m_used = true;
+			return m_storage;
+		}
+		return allocator_allocate(static_cast<Alloc&>(*this), bytes, c_allocator_alignment);
+	}
+
+	template<typename T, size_t N, typename Alloc>
+	inline void* small_vector_allocator<T, N, Alloc>::static_allocate(size_t bytes, size_t alignment) {
+		if (bytes <= c_capacity && !m_used) {
+			m_used = true;
+			return m_storage;
+		}
+		return allocator_allocate(static_cast<Alloc&>(*this), bytes, alignment);
+	}
+
+	template<typename T, size_t N, typename Alloc>
+	inline void* small_vector_allocator<T, N, Alloc>::static_allocate_at_least(size_t bytes, size_t* actual) {
+		if (bytes <= c_capacity && !m_used) {
+			m_used = true;
+			*actual = c_capacity;
+			return m_storage;
+		}
+		return allocator_allocate_at_least(static_cast<Alloc&>(*this), bytes, c_allocator_alignment, actual);
+	}
+
+	// Blocks never move between the inline storage and the heap here; the
+	// container falls back to allocate/move/deallocate for that.
+	template<typename T, size_t N, typename Alloc>
+	inline void* small_vector_allocator<T, N, Alloc>::static_reallocate(void* ptr, size_t oldbytes, size_t newbytes) {
+		if (is_inline(ptr))
+			return (newbytes <= c_capacity) ? ptr : 0;
+		if (newbytes <= c_capacity && !m_used)
+			return 0;
+		return allocator_reallocate(static_cast<Alloc&>(*this), ptr, oldbytes, newbytes, c_allocator_alignment);
+	}
+
+	template<typename T, size_t N, typename Alloc>
+	inline void small_vector_allocator<T, N, Alloc>::static_deallocate(void* ptr, size_t bytes) {
+		if (is_inline(ptr))
+			m_used = false;
+		else
+			allocator_deallocate(static_cast<Alloc&>(*this), ptr, bytes, c_allocator_alignment);
+	}
+
+	template<typename T, size_t N, typename Alloc>
+	inline void small_vector_allocator<T, N, Alloc>::static_deallocate(void* ptr, size_t bytes, size_t alignment) {
+		if (is_inline(ptr))
+			m_used = false;
+		else
+			allocator_deallocate(static_cast<Alloc&>(*this), ptr, bytes, alignment);
+	}
+
+	// Inline elements cannot change owners by pointer, so they are moved
+	// one by one into the destination's own storage.
+	template<typename T, size_t N, typename Alloc>
+	static inline void buffer_move(buffer<T, small_vector_allocator<T, N, Alloc> >* dst, buffer<T, small_vector_allocator<T, N, Alloc> >* src) {
+		static_cast<small_vector_allocator<T, N, Alloc>&>(*dst) = *src;
+		if (!src->is_inline(src->first)) {
+			dst->first = src->first, dst->last = src->last, dst->capacity = src->capacity;
+			src->first = src->last = src->capacity = nullptr;
+			return;
+		}
+
+		const size_t size = (size_t)(src->last - src->first);
+		buffer_init(dst);
+		buffer_reserve(dst, size);
+		buffer_move_urange(dst->first, src->first, src->last);
+		dst->last = dst->first + size;
+		src->last = src->first;
+	}
+
+	template<typename T, size_t N, typename Alloc>
+	static inline void buffer_swap(buffer<T, small_vector_allocator<T, N, Alloc> >* b, buffer<T, small_vector_allocator<T, N, Alloc> >* other) {
+		typedef small_vector_allocator<T, N, Alloc> allocator_type;
+		if (!b->is_inline(b->first) && !other->is_inline(other->first)) {
+			T* const tfirst = b->first, * const tlast = b->last, * const tcapacity = b->capacity;
+			b->first = other->first, b->last = other->last, b->capacity = other->capacity;
+			other->first = tfirst, other->last = tlast, other->capacity = tcapacity;
+
+			const allocator_type talloc = *b;
+			static_cast<allocator_type&>(*b) = *other;
+			static_cast<allocator_type&>(*other) = talloc;
+			return;
+		}
+
+		buffer<T, allocator_type> temp(*b);
+		buffer_move(&temp, b);
+		buffer_destroy(b);
+		buffer_move(b, other);
+		buffer_destroy(other);
+		buffer_move(other, &temp);
+		buffer_destroy(&temp);
+	}
+}
+
+#endif
@@ -0,0 +1,254 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TINYSTL_SPSC_QUEUE_H
+#define TINYSTL_SPSC_QUEUE_H
+
+#include <TINYSTL/allocator.h>
+#include <TINYSTL/atomic.h>
+#include <TINYSTL/new.h>
+#include <TINYSTL/stddef.h>
+#include <TINYSTL/traits.h>
+
+namespace tinystl {
+
+	// Bounded lock-free queue for exactly one producer thread and one
+	// consumer thread. Capacity is rounded up to a power of two.
+	//
+	// Each side owns a cache line holding its own index and a cached copy of
+	// the other side's index, so the shared line is only read when the
+	// cached copy says the queue looks full (producer) or empty (consumer).
+	template<typename T, typename Alloc = TINYSTL_ALLOCATOR>
+	class spsc_queue {
+	public:
+		explicit spsc_queue(size_t capacity);
+		spsc_queue(size_t capacity, const Alloc& alloc);
+		~spsc_queue();
+
+		const Alloc& get_allocator() const;
+
+		size_t capacity() const;
+
+		// Approximate unless called from the producer or consumer thread
+		size_t size() const;
+		bool empty() const;
+
+		// Producer side; these fail and leave the argument untouched when full
+		bool push(const T& t);
+		bool push(T&& t);
+
+		template<typename... Args>
+		bool emplace(Args&&... args);
+
+		// Enqueues as many of [first, last) as fit; returns how many
+		size_t push(const T* first, const T* last);
+
+		// Consumer side; these fail when empty
+		bool pop(T& out);
+		bool pop();
+
+		// Moves up to last - first elements into [first, last); returns how many
+		size_t pop(T* first, T* last);
+
+	private:
+		spsc_queue(const spsc_queue&);
+		spsc_queue& operator=(const spsc_queue&);
+
+		void init(size_t capacity);
+		size_t writable(size_t tail, size_t wanted);
+		size_t readable(size_t head, size_t wanted);
+
+		struct storage : Alloc {
+			storage() {}
+			explicit storage(const Alloc& alloc) : Alloc(alloc) {}
+
+			T* data;
+			size_t mask;
+		};
+
+		storage m_storage;
+
+		alignas(TINYSTL_CACHE_LINE_SIZE) size_t m_tail;
+		size_t m_cachedhead;
+
+		alignas(TINYSTL_CACHE_LINE_SIZE) size_t m_head;
+		size_t m_cachedtail;
+	};
+
+	template<typename T, typename Alloc>
+	inline spsc_queue<T, Alloc>::spsc_queue(size_t capacity) {
+		init(capacity);
+	}
+
+	template<typename T, typename Alloc>
+	inline spsc_queue<T, Alloc>::spsc_queue(size_t capacity, const Alloc& alloc)
+		: m_storage(alloc)
+	{
+		init(capacity);
+	}
+
+	template<typename T, typename Alloc>
+	inline void spsc_queue<T, Alloc>::init(size_t capacity) {
+		size_t size = 2;
+		while (size < capacity)
+			size *= 2;
+
+		m_storage.data = (T*)allocator_allocate(static_cast<Alloc&>(m_storage), sizeof(T) * size, alignof(T));
+		m_storage.mask = size - 1;
+		m_tail = m_cachedhead = 0;
+		m_head = m_cachedtail = 0;
+	}
+
+	template<typename T, typename Alloc>
+	inline spsc_queue<T, Alloc>::~spsc_queue() {
+		for (size_t it = m_head; it != m_tail; ++it)
+			m_storage.data[it & m_storage.mask].~T();
+		allocator_deallocate(static_cast<Alloc&>(m_storage), m_storage.data, sizeof(T) * (m_storage.mask + 1), alignof(T));
+	}
+
+	template<typename T, typename Alloc>
+	inline const Alloc& spsc_queue<T, Alloc>::get_allocator() const {
+		return m_storage;
+	}
+
+	template<typename T, typename Alloc>
+	inline size_t spsc_queue<T, Alloc>::capacity() const {
+		return m_storage.mask + 1;
+	}
+
+	template<typename T, typename Alloc>
+	inline size_t spsc_queue<T, Alloc>::size() const {
+		const size_t head = atomic_load_acquire(&m_head);
+		return atomic_load_acquire(&m_tail) - head;
+	}
+
+	template<typename T, typename Alloc>
+	inline bool spsc_queue<T, Alloc>::empty() const {
+		return size() == 0;
+	}
+
+	// Returns how many of wanted slots are free past tail, refreshing the
+	// cached head only if the cached value is not enough
+	template<typename T, typename Alloc>
+	inline size_t spsc_queue<T, Alloc>::writable(size_t tail, size_t wanted) {
+		const size_t capacity = m_storage.mask + 1;
+		size_t room = capacity - (tail - m_cachedhead);
+		if (room < wanted) {
+			m_cachedhead = atomic_load_acquire(&m_head);
+			room = capacity - (tail - m_cachedhead);
+		}
+		return (room < wanted) ? room : wanted;
+	}
+
+	template<typename T, typename Alloc>
+	inline size_t spsc_queue<T, Alloc>::readable(size_t head, size_t wanted) {
+		size_t count = m_cachedtail - head;
+		if (count < wanted) {
+			m_cachedtail = atomic_load_acquire(&m_tail);
+			count = m_cachedtail - head;
+		}
+		return (count < wanted) ? count : wanted;
+	}
+
+	template<typename T, typename Alloc>
+	inline bool spsc_queue<T, Alloc>::push(const T& t) {
+		const size_t tail = m_tail;
+		if (!writable(tail, 1))
+			return false;
+
+		new(placeholder(), m_storage.data + (tail & m_storage.mask)) T(t);
+		atomic_store_release(&m_tail, tail + 1);
+		return true;
+	}
+
+	template<typename T, typename Alloc>
+	inline bool spsc_queue<T, Alloc>::push(T&& t) {
+		return emplace(static_cast<T&&>(t));
+	}
+
+	template<typename T, typename Alloc>
+	template<typename... Args>
+	inline bool spsc_queue<T, Alloc>::emplace(Args&&... args) {
+		const size_t tail = m_tail;
+		if (!writable(tail, 1))
+			return false;
+
+		new(placeholder(), m_storage.data + (tail & m_storage.mask)) T(static_cast<Args&&>(args)...);
+		atomic_store_release(&m_tail, tail + 1);
+		return true;
+	}
+
+	template<typename T, typename Alloc>
+	inline size_t spsc_queue<T, Alloc>::push(const T* first, const T* last) {
+		const size_t tail = m_tail;
+		const size_t count = writable(tail, (size_t)(last - first));
+
+		for (size_t ii = 0; ii != count; ++ii)
+			new(placeholder(), m_storage.data + ((tail + ii) & m_storage.mask)) T(first[ii]);
+		atomic_store_release(&m_tail, tail + count);
+		return count;
+	}
+
+	template<typename T, typename Alloc>
+	inline bool spsc_queue<T, Alloc>::pop(T& out) {
+		const size_t head = m_head;
+		if (!readable(head, 1))
+			return false;
+
+		T* slot = m_storage.data + (head & m_storage.mask);
+		move(out, *slot);
+		slot->~T();
+		atomic_store_release(&m_head, head + 1);
+		return true;
+	}
+
+	template<typename T, typename Alloc>
+	inline bool spsc_queue<T, Alloc>::pop() {
+		const size_t head = m_head;
+		if (!readable(head, 1))
+			return false;
+
+		m_storage.data[head & m_storage.mask].~T();
+		atomic_store_release(&m_head, head + 1);
+		return true;
+	}
+
+	template<typename T, typename Alloc>
+	inline size_t spsc_queue<T, Alloc>::pop(T* first, T* last) {
+		const size_t head = m_head;
+		const size_t count = readable(head, (size_t)(last - first));
+
+		for (size_t ii = 0; ii != count; ++ii) {
+			T* slot = m_storage.data + ((head + ii) & m_storage.mask);
+			move(first[ii], *slot);
+			slot->~T();
+		}
+		atomic_store_release(&m_head, head + count);
+		return count;
+	}
+}
+
+#endif
@@ -0,0 +1,418 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TINYSTL_STATIC_VECTOR_H
+#define TINYSTL_STATIC_VECTOR_H
+
+#include <TINYSTL/buffer.h>
+#include <TINYSTL/new.h>
+#include <TINYSTL/stddef.h>
+#include <TINYSTL/traits.h>
+
+namespace tinystl {
+
+	// The smallest unsigned type that can count to N
+	template<size_t N, bool byte = (N <= 0xff), bool word = (N <= 0xffff), bool dword = (N <= 0xffffffffull)>
+	struct static_vector_size {
+		typedef size_t type;
+	};
+
+	template<size_t N>
+	struct static_vector_size<N, true, true, true> {
+		typedef unsigned char type;
+	};
+
+	template<size_t N>
+	struct static_vector_size<N, false, true, true> {
+		typedef unsigned short type;
+	};
+
+	template<size_t N>
+	struct static_vector_size<N, false, false, true> {
+		typedef unsigned int type;
+	};
+
+	// A vector with room for N elements inside the object that never
+	// touches an allocator. Operations that would grow past N leave the
+	// vector unchanged and return false.
+	template<typename T, size_t N>
+	class static_vector {
+	public:
+		static_vector();
+		static_vector(const static_vector& other);
+		static_vector(static_vector&& other);
+		~static_vector();
+
+		static_vector& operator=(const static_vector& other);
+		static_vector& operator=(static_vector&& other);
+
+		const T* data() const;
+		T* data();
+		size_t size() const;
+		size_t capacity() const;
+		bool empty() const;
+		bool full() const;
+
+		T& operator[](size_t idx);
+		const T& operator[](size_t idx) const;
+
+		const T& front() const;
+		T& front();
+		const T& back() const;
+		T& back();
+
+		bool resize(size_t size);
+		bool resize(size_t size, const T& value);
+		void clear();
+
+		bool push_back(const T& t);
+		bool push_back(T&& t);
+		void pop_back();
+
+		template<typename... Args>
+		bool emplace_back(Args&&... args);
+
+		void swap(static_vector& other);
+
+		typedef T value_type;
+
+		typedef T* iterator;
+		iterator begin();
+		iterator end();
+
+		typedef const T* const_iterator;
+		const_iterator begin() const;
+		const_iterator end() const;
+
+		bool insert(iterator where, const T& value);
+		bool insert(iterator where, T&& value);
+		bool insert(iterator where, const T* first, const T* last);
+
+		template<typename... Args>
+		bool emplace(iterator where, Args&&... args);
+
+		iterator erase(iterator where);
+		iterator erase(iterator first, iterator last);
+
+		iterator erase_unordered(iterator where);
+		iterator erase_unordered(iterator first, iterator last);
+
+	private:
+		T* insert_common(T* where, size_t count);
+
+		typedef typename static_vector_size<N>::type size_type;
+
+		alignas(T) char m_storage[N * sizeof(T)];
+		size_type m_size;
+	};
+
+	template<typename T, size_t N>
+	inline static_vector<T, N>::static_vector()
+		: m_size(0)
+	{
+	}
+
+	template<typename T, size_t N>
+	inline static_vector<T, N>::static_vector(const static_vector& other)
+		: m_size(other.m_size)
+	{
+		T* dest = data();
+		for (const T* it = other.begin(), *end = other.end(); it != end; ++it, ++dest)
+			new(placeholder(), dest) T(*it);
+	}
+
+	template<typename T, size_t N>
+	inline static_vector<T, N>::static_vector(static_vector&& other)
+		: m_size(other.m_size)
+	{
+		buffer_move_urange(data(), other.begin(), other.end());
+		other.m_size = 0;
+	}
+
+	template<typename T, size_t N>
+	inline static_vector<T, N>::~static_vector() {
+		buffer_destroy_range(begin(), end());
+	}
+
+	template<typename T, size_t N>
+	inline static_vector<T, N>& static_vector<T, N>::operator=(const static_vector& other) {
+		if (this != &other) {
+			clear();
+			T* dest = data();
+			for (const T* it = other.begin(), *end = other.end(); it != end; ++it, ++dest)
+				new(placeholder(), dest) T(*it);
+			m_size = other.m_size;
+		}
+		return *this;
+	}
+
+	template<typename T, size_t N>
+	inline static_vector<T, N>& static_vector<T, N>::operator=(static_vector&& other) {
+		if (this != &other) {
+			clear();
+			buffer_move_urange(data(), other.begin(), other.end());
+			m_size = other.m_size;
+			other.m_size = 0;
+		}
+		return *this;
+	}
+
+	template<typename T, size_t N>
+	inline const T* static_vector<T, N>::data() const {
+		return (const T*)m_storage;
+	}
+
+	template<typename T, size_t N>
+	inline T* static_vector<T, N>::data() {
+		return (T*)m_storage;
+	}
+
+	template<typename T, size_t N>
+	inline size_t static_vector<T, N>::size() const {
+		return m_size;
+	}
+
+	template<typename T, size_t N>
+	inline size_t static_vector<T, N>::capacity() const {
+		return N;
+	}
+
+	template<typename T, size_t N>
+	inline bool static_vector<T, N>::empty() const {
+		return m_size == 0;
+	}
+
+	template<typename T, size_t N>
+	inline bool static_vector<T, N>::full() const {
+		return m_size == N;
+	}
+
+	template<typename T, size_t N>
+	inline T& static_vector<T, N>::operator[](size_t idx) {
+		return data()[idx];
+	}
+
+	template<typename T, size_t N>
+	inline const T& static_vector<T, N>::operator[](size_t idx) const {
+		return data()[idx];
+	}
+
+	template<typename T, size_t N>
+	inline const T& static_vector<T, N>::front() const {
+		return data()[0];
+	}
+
+	template<typename T, size_t N>
+	inline T& static_vector<T, N>::front() {
+		return data()[0];
+	}
+
+	template<typename T, size_t N>
+	inline const T& static_vector<T, N>::back() const {
+		return data()[m_size - 1];
+	}
+
+	template<typename T, size_t N>
+	inline T& static_vector<T, N>::back() {
+		return data()[m_size - 1];
+	}
+
+	template<typename T, size_t N>
+	inline bool static_vector<T, N>::resize(size_t size) {
+		if (size > N)
+			return false;
+
+		buffer_fill_urange(end(), data() + size);
+		buffer_destroy_range(data() + size, end());
+		m_size = (size_type)size;
+		return true;
+	}
+
+	template<typename T, size_t N>
+	inline bool static_vector<T, N>::resize(size_t size, const T& value) {
+		if (size > N)
+			return false;
+
+		buffer_fill_urange(end(), data() + size, value);
+		buffer_destroy_range(data() + size, end());
+		m_size = (size_type)size;
+		return true;
+	}
+
+	template<typename T, size_t N>
+	inline void static_vector<T, N>::clear() {
+		buffer_destroy_range(begin(), end());
+		m_size = 0;
+	}
+
+	template<typename T, size_t N>
+	inline bool static_vector<T, N>::push_back(const T& t) {
+		if (m_size == N)
+			return false;
+
+		new(placeholder(), end()) T(t);
+		++m_size;
+		return true;
+	}
+
+	template<typename T, size_t N>
+	inline bool static_vector<T, N>::push_back(T&& t) {
+		if (m_size == N)
+			return false;
+
+		new(placeholder(), end()) T(static_cast<T&&>(t));
+		++m_size;
+		return true;
+	}
+
+	template<typename T, size_t N>
+	inline void static_vector<T, N>::pop_back() {
+		--m_size;
+		end()->~T();
+	}
+
+	template<typename T, size_t N>
+	template<typename... Args>
+	inline bool static_vector<T, N>::emplace_back(Args&&... args) {
+		if (m_size == N)
+			return false;
+
+		new(placeholder(), end()) T(static_cast<Args&&>(args)...);
+		++m_size;
+		return true;
+	}
+
+	template<typename T, size_t N>
+	inline void static_vector<T, N>::swap(static_vector& other) {
+		static_vector temp(static_cast<static_vector&&>(*this));
+		*this = static_cast<static_vector&&>(other);
+		other = static_cast<static_vector&&>(temp);
+	}
+
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::iterator static_vector<T, N>::begin() {
+		return data();
+	}
+
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::iterator static_vector<T, N>::end() {
+		return data() + m_size;
+	}
+
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::const_iterator static_vector<T, N>::begin() const {
+		return data();
+	}
+
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::const_iterator static_vector<T, N>::end() const {
+		return data() + m_size;
+	}
+
+	// Opens count uninitialized slots at where, or returns 0 if they do not fit
+	template<typename T, size_t N>
+	inline T* static_vector<T, N>::insert_common(T* where, size_t count) {
+		if (count > N - m_size)
+			return 0;
+
+		if (where != end())
+			buffer_bmove_urange(where + count, where, end());
+		m_size = (size_type)(m_size + count);
+		return where;
+	}
+
+	template<typename T, size_t N>
+	inline bool static_vector<T, N>::insert(iterator where, const T& value) {
+		return insert(where, &value, &value + 1);
+	}
+
+	template<typename T, size_t N>
+	inline bool static_vector<T, N>::insert(iterator where, T&& value) {
+		return emplace(where, static_cast<T&&>(value));
+	}
+
+	template<typename T, size_t N>
+	inline bool static_vector<T, N>::insert(iterator where, const T* first, const T* last) {
+		const size_t count = (size_t)(last - first);
+
+		const bool shifted = (first >= where && first < end());
+		if (!insert_common(where, count))
+			return false;
+
+		if (shifted) {
+			first += count;
+			last += count;
+		}
+
+		for (; first != last; ++first, ++where)
+			new(placeholder(), where) T(*first);
+		return true;
+	}
+
+	template<typename T, size_t N>
+	template<typename... Args>
+	inline bool static_vector<T, N>::emplace(iterator where, Args&&... args) {
+		if (m_size == N)
+			return false;
+
+		// args may refer to elements that are about to shift
+		T value(static_cast<Args&&>(args)...);
+		where = insert_common(where, 1);
+		move_construct(where, value);
+		return true;
+	}
+
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::iterator static_vector<T, N>::erase(iterator where) {
+		return erase(where, where + 1);
+	}
+
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::iterator static_vector<T, N>::erase(iterator first, iterator last) {
+		buffer_erase_traits(first, last, end(), relocatable_traits<T>());
+		m_size = (size_type)(m_size - (last - first));
+		return first;
+	}
+
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::iterator static_vector<T, N>::erase_unordered(iterator where) {
+		return erase_unordered(where, where + 1);
+	}
+
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::iterator static_vector<T, N>::erase_unordered(iterator first, iterator last) {
+		buffer_erase_unordered_traits(first, last, end(), relocatable_traits<T>());
+		m_size = (size_type)(m_size - (last - first));
+		return first;
+	}
+
+	template<typename T, size_t N>
+	struct is_trivially_relocatable<static_vector<T, N> > {
+		static const bool value = is_trivially_relocatable<T>::value;
+	};
+}
+
+#endif
@@ -34,23 +34,31 @@
 namespace tinystl {
 
 	template<typename Allocator>
-	class basic_string {
+	class basic_string : private Allocator {
 	public:
 		basic_string();
+		explicit basic_string(const Allocator& alloc);
 		basic_string(const basic_string& other);
 		basic_string(basic_string&& other);
 		basic_string(const char* sz);
 		basic_string(const char* sz, size_t len);
+		basic_string(const char* sz, const Allocator& alloc);
+		basic_string(const char* sz, size_t len, const Allocator& alloc);
 		~basic_string();
 
 		basic_string& operator=(const basic_string& other);
 		basic_string& operator=(basic_string&& other);
 
+		const Allocator& get_allocator() const;
+
 		const char* c_str() const;
+		const char* data() const;
+		char* data();
 		size_t size() const;
 
 		void reserve(size_t size);
 		void resize(size_t size);
+		void resize_uninitialized(size_t size);
 
 		void clear();
 		void append(const char* first, const char* last);
@@ -78,9 +86,20 @@ namespace tinystl {
 		resize(0);
 	}
 
+	template<typename allocator>
+	inline basic_string<allocator>::basic_string(const allocator& alloc)
+		: allocator(alloc)
+		, m_first(m_buffer)
+		, m_last(m_buffer)
+		, m_capacity(m_buffer + c_nbuffer)
+	{
+		resize(0);
+	}
+
 	template<typename allocator>
 	inline basic_string<allocator>::basic_string(const basic_string& other)
-		: m_first(m_buffer)
+		: allocator(other)
+		, m_first(m_buffer)
 		, m_last(m_buffer)
 		, m_capacity(m_buffer + c_nbuffer)
 	{
@@ -90,6 +109,7 @@ namespace tinystl {
 
 	template<typename allocator>
 	inline basic_string<allocator>::basic_string(basic_string&& other)
+		: allocator(other)
 	{
 		if (other.m_first == other.m_buffer) {
 			m_first = m_buffer;
@@ -131,10 +151,36 @@ namespace tinystl {
 		append(sz, sz + len);
 	}
 
+	template<typename allocator>
+	inline basic_string<allocator>::basic_string(const char* sz, const allocator& alloc)
+		: allocator(alloc)
+		, m_first(m_buffer)
+		, m_last(m_buffer)
+		, m_capacity(m_buffer + c_nbuffer)
+	{
+		size_t len = 0;
+		for (const char* it = sz; *it; ++it)
+			++len;
+
+		reserve(len);
+		append(sz, sz + len);
+	}
+
+	template<typename allocator>
+	inline basic_string<allocator>::basic_string(const char* sz, size_t len, const allocator& alloc)
+		: allocator(alloc)
+		, m_first(m_buffer)
+		, m_last(m_buffer)
+		, m_capacity(m_buffer + c_nbuffer)
+	{
+		reserve(len);
+		append(sz, sz + len);
+	}
+
 	template<typename allocator>
 	inline basic_string<allocator>::~basic_string() {
 		if (m_first != m_buffer)
-			allocator::static_deallocate(m_first, m_capacity - m_first);
+			allocator_deallocate(static_cast<allocator&>(*this), m_first, (size_t)(m_capacity - m_first), alignof(char));
 	}
 
 	template<typename allocator>
@@ -149,11 +195,26 @@ namespace tinystl {
 		return *this;
 	}
 
+	template<typename allocator>
+	inline const allocator& basic_string<allocator>::get_allocator() const {
+		return *this;
+	}
+
 	template<typename allocator>
 	inline const char* basic_string<allocator>::c_str() const {
 		return m_first;
 	}
 
+	template<typename allocator>
+	inline const char* basic_string<allocator>::data() const {
+		return m_first;
+	}
+
+	template<typename allocator>
+	inline char* basic_string<allocator>::data() {
+		return m_first;
+	}
+
 	template<typename allocator>
 	inline size_t basic_string<allocator>::size() const
 	{
@@ -167,15 +228,23 @@ namespace tinystl {
 
 		const size_t size = (size_t)(m_last - m_first);
 
-		pointer newfirst = (pointer)allocator::static_allocate(capacity + 1);
-		for (pointer it = m_first, newit = newfirst, end = m_last; it != end; ++it, ++newit)
-			*newit = *it;
+		size_t bytes = capacity + 1;
+		pointer newfirst = 0;
 		if (m_first != m_buffer)
-			allocator::static_deallocate(m_first, m_capacity - m_first);
+			newfirst = (pointer)allocator_reallocate(static_cast<allocator&>(*this), m_first, (size_t)(m_capacity - m_first), bytes, alignof(char));
+
+		if (!newfirst) {
+			newfirst = (pointer)allocator_allocate_at_least(static_cast<allocator&>(*this), bytes, alignof(char), &bytes);
+			for (pointer it = m_first, newit = newfirst, end = m_last; it != end; ++it, ++newit)
+				*newit = *it;
+			if (m_first != m_buffer)
+				allocator_deallocate(static_cast<allocator&>(*this), m_first, (size_t)(m_capacity - m_first), alignof(char));
+		}
 
 		m_first = newfirst;
 		m_last = newfirst + size;
-		m_capacity = m_first + capacity;
+		m_capacity = newfirst + bytes;
+		*m_last = 0;
 	}
 
 	template<typename allocator>
@@ -185,12 +254,20 @@ namespace tinystl {
 		if (size > prevSize)
 			for (pointer it = m_last, end = m_first + size + 1; it < end; ++it)
 				*it = 0;
-		else if (m_last != m_first)
+		else
 			m_first[size] = 0;
 
 		m_last = m_first + size;
 	}
 
+	// Grows without touching the new bytes; only the terminator is written
+	template<typename allocator>
+	inline void basic_string<allocator>::resize_uninitialized(size_t size) {
+		reserve(size);
+		m_last = m_first + size;
+		*m_last = 0;
+	}
+
 	template<typename allocator>
 	inline void basic_string<allocator>::clear() {
 		resize(0);
@@ -200,7 +277,7 @@ namespace tinystl {
 	inline void basic_string<allocator>::append(const char* first, const char* last) {
 		const size_t newsize = (size_t)((m_last - m_first) + (last - first) + 1);
 		if (m_first + newsize > m_capacity)
-			reserve((newsize * 3) / 2);
+			reserve(allocator_grow(static_cast<allocator&>(*this), (size_t)(m_capacity - m_first), newsize));
 
 		for (; first != last; ++m_last, ++first)
 			*m_last = *first;
@@ -217,20 +294,22 @@ namespace tinystl {
 	inline void basic_string<allocator>::shrink_to_fit() {
 		if (m_first == m_buffer) {
 		} else if (m_last == m_first) {
-			const size_t capacity = (size_t)(m_capacity - m_first);
-			if (capacity)
-				allocator::static_deallocate(m_first, capacity+1);
-			m_capacity = m_first;
-		} else if (m_capacity != m_last) {
+			allocator_deallocate(static_cast<allocator&>(*this), m_first, (size_t)(m_capacity - m_first), alignof(char));
+			m_first = m_last = m_buffer;
+			m_capacity = m_buffer + c_nbuffer;
+			*m_last = 0;
+		} else if (m_capacity != m_last + 1) {
 			const size_t size = (size_t)(m_last - m_first);
-			char* newfirst = (pointer)allocator::static_allocate(size+1);
-			for (pointer in = m_first, out = newfirst; in != m_last + 1; ++in, ++out)
-				*out = *in;
-			if (m_first != m_capacity)
-				allocator::static_deallocate(m_first, m_capacity+1-m_first);
+			char* newfirst = (pointer)allocator_reallocate(static_cast<allocator&>(*this), m_first, (size_t)(m_capacity - m_first), size+1, alignof(char));
+			if (!newfirst) {
+				newfirst = (pointer)allocator_allocate(static_cast<allocator&>(*this), size+1, alignof(char));
+				for (pointer in = m_first, out = newfirst; in != m_last + 1; ++in, ++out)
+					*out = *in;
+				allocator_deallocate(static_cast<allocator&>(*this), m_first, (size_t)(m_capacity - m_first), alignof(char));
+			}
 			m_first = newfirst;
 			m_last = newfirst+size;
-			m_capacity = m_last;
+			m_capacity = m_last + 1;
 		}
 	}
 
@@ -240,6 +319,10 @@ namespace tinystl {
 		m_first = other.m_first, m_last = other.m_last, m_capacity = other.m_capacity;
 		other.m_first = tfirst, other.m_last = tlast, other.m_capacity = tcapacity;
 
+		const allocator talloc = *this;
+		static_cast<allocator&>(*this) = other;
+		static_cast<allocator&>(other) = talloc;
+
 		char tbuffer[c_nbuffer];
 
 		if (m_first == other.m_buffer)
@@ -0,0 +1,235 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TINYSTL_THREAD_CACHE_ALLOCATOR_H
+#define TINYSTL_THREAD_CACHE_ALLOCATOR_H
+
+#include <TINYSTL/allocator.h>
+#include <TINYSTL/atomic.h>
+#include <TINYSTL/stddef.h>
+
+namespace tinystl {
+
+	// Size-class allocator with a bounded per-thread cache in front of a
+	// shared depot. Blocks up to c_thread_cache_max_size bytes are served
+	// from the calling thread's cache; when a cache bin fills up half of it
+	// is handed to the depot in one batch, and an empty bin refills with a
+	// batch from the depot before falling back to tinystl::allocator.
+	//
+	// To use it for every container:
+	//   #define TINYSTL_ALLOCATOR ::tinystl::thread_cache_allocator
+	//   #include <TINYSTL/thread_cache_allocator.h>
+	struct thread_cache_allocator {
+		static void* static_allocate(size_t bytes);
+		static void* static_allocate_at_least(size_t bytes, size_t* actual);
+		static void* static_reallocate(void* ptr, size_t oldbytes, size_t newbytes);
+		static void static_deallocate(void* ptr, size_t bytes);
+	};
+
+	static const size_t c_thread_cache_max_size = 32 * 1024;
+	static const size_t c_thread_cache_nclasses = 40;
+	static const unsigned c_thread_cache_bin_limit = 64;
+
+	// 16 byte steps up to 128 bytes, then four classes per power of two
+	static inline size_t thread_cache_size_class(size_t bytes) {
+		if (bytes <= 128)
+			return bytes ? (bytes - 1) / 16 : 0;
+
+		size_t log2 = 7;
+		while ((bytes - 1) >> (log2 + 1))
+			++log2;
+
+		const size_t step = ((bytes - 1) - ((size_t)1 << log2)) >> (log2 - 2);
+		return 8 + (log2 - 7) * 4 + step;
+	}
+
+	static inline size_t thread_cache_class_size(size_t sizeclass) {
+		if (sizeclass < 8)
+			return (sizeclass + 1) * 16;
+
+		const size_t log2 = 7 + (sizeclass - 8) / 4;
+		const size_t step = (sizeclass - 8) % 4;
+		return ((size_t)1 << log2) + ((step + 1) << (log2 - 2));
+	}
+
+	// Free blocks are chained through their first word. The first block of
+	// a batch in the depot links to the next batch through its second word.
+	struct thread_cache_block {
+		thread_cache_block* next;
+		thread_cache_block* nextbatch;
+	};
+
+	struct thread_cache_depot {
+		spinlock lock[c_thread_cache_nclasses];
+		thread_cache_block* batches[c_thread_cache_nclasses];
+	};
+
+	// not static: every translation unit must share the same depot and caches
+	inline thread_cache_depot* thread_cache_get_depot() {
+		static thread_cache_depot s_depot;
+		return &s_depot;
+	}
+
+	static inline void thread_cache_depot_push(size_t sizeclass, thread_cache_block* batch) {
+		thread_cache_depot* depot = thread_cache_get_depot();
+		spinlock_lock(&depot->lock[sizeclass]);
+		batch->nextbatch = depot->batches[sizeclass];
+		depot->batches[sizeclass] = batch;
+		spinlock_unlock(&depot->lock[sizeclass]);
+	}
+
+	static inline thread_cache_block* thread_cache_depot_pop(size_t sizeclass) {
+		thread_cache_depot* depot = thread_cache_get_depot();
+		if (!atomic_load_relaxed(&depot->batches[sizeclass]))
+			return 0;
+
+		spinlock_lock(&depot->lock[sizeclass]);
+		thread_cache_block* batch = depot->batches[sizeclass];
+		if (batch)
+			depot->batches[sizeclass] = batch->nextbatch;
+		spinlock_unlock(&depot->lock[sizeclass]);
+		return batch;
+	}
+
+	struct thread_cache {
+		thread_cache();
+		~thread_cache();
+
+		thread_cache_block* bins[c_thread_cache_nclasses];
+		unsigned counts[c_thread_cache_nclasses];
+		bool active;
+	};
+
+	inline thread_cache::thread_cache()
+		: active(true)
+	{
+		for (size_t ii = 0; ii < c_thread_cache_nclasses; ++ii) {
+			bins[ii] = 0;
+			counts[ii] = 0;
+		}
+	}
+
+	inline thread_cache::~thread_cache() {
+		for (size_t ii = 0; ii < c_thread_cache_nclasses; ++ii) {
+			if (bins[ii])
+				thread_cache_depot_push(ii, bins[ii]);
+			bins[ii] = 0;
+			counts[ii] = 0;
+		}
+
+		// frees issued by later thread-local destructors go straight to the depot
+		active = false;
+	}
+
+	inline thread_cache* thread_cache_get() {
+		static thread_local thread_cache s_cache;
+		return &s_cache;
+	}
+
+	inline void* thread_cache_allocator::static_allocate(size_t bytes) {
+		if (bytes > c_thread_cache_max_size)
+			return allocator::static_allocate(bytes);
+
+		const size_t sizeclass = thread_cache_size_class(bytes);
+		thread_cache* cache = thread_cache_get();
+
+		thread_cache_block* block = cache->bins[sizeclass];
+		if (block) {
+			cache->bins[sizeclass] = block->next;
+			--cache->counts[sizeclass];
+			return block;
+		}
+
+		block = thread_cache_depot_pop(sizeclass);
+		if (!block)
+			return allocator::static_allocate(thread_cache_class_size(sizeclass));
+
+		if (cache->active) {
+			unsigned count = 0;
+			for (thread_cache_block* it = block->next; it; it = it->next)
+				++count;
+			cache->bins[sizeclass] = block->next;
+			cache->counts[sizeclass] = count;
+		} else if (block->next) {
+			thread_cache_depot_push(sizeclass, block->next);
+		}
+
+		return block;
+	}
+
+	inline void* thread_cache_allocator::static_allocate_at_least(size_t bytes, size_t* actual) {
+		if (bytes > c_thread_cache_max_size)
+			return allocator::static_allocate_at_least(bytes, actual);
+
+		*actual = thread_cache_class_size(thread_cache_size_class(bytes));
+		return static_allocate(bytes);
+	}
+
+	inline void* thread_cache_allocator::static_reallocate(void* ptr, size_t oldbytes, size_t newbytes) {
+		if (oldbytes > c_thread_cache_max_size || newbytes > c_thread_cache_max_size)
+			return (oldbytes > c_thread_cache_max_size && newbytes > c_thread_cache_max_size) ? allocator::static_reallocate(ptr, oldbytes, newbytes) : 0;
+
+		// the block already spans its whole size class
+		return (thread_cache_size_class(oldbytes) == thread_cache_size_class(newbytes)) ? ptr : 0;
+	}
+
+	inline void thread_cache_allocator::static_deallocate(void* ptr, size_t bytes) {
+		if (!ptr)
+			return;
+
+		if (bytes > c_thread_cache_max_size) {
+			allocator::static_deallocate(ptr, bytes);
+			return;
+		}
+
+		const size_t sizeclass = thread_cache_size_class(bytes);
+		thread_cache* cache = thread_cache_get();
+		thread_cache_block* block = (thread_cache_block*)ptr;
+
+		if (!cache->active) {
+			block->next = 0;
+			thread_cache_depot_push(sizeclass, block);
+			return;
+		}
+
+		if (cache->counts[sizeclass] == c_thread_cache_bin_limit) {
+			// hand the older half of the bin to the depot as one batch
+			thread_cache_block* keep = cache->bins[sizeclass];
+			for (unsigned ii = 1; ii < c_thread_cache_bin_limit / 2; ++ii)
+				keep = keep->next;
+
+			thread_cache_depot_push(sizeclass, keep->next);
+			keep->next = 0;
+			cache->counts[sizeclass] = c_thread_cache_bin_limit / 2;
+		}
+
+		block->next = cache->bins[sizeclass];
+		cache->bins[sizeclass] = block;
+		++cache->counts[sizeclass];
+	}
+}
+
+#endif
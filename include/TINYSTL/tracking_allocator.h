@@ -0,0 +1,267 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TINYSTL_TRACKING_ALLOCATOR_H
+#define TINYSTL_TRACKING_ALLOCATOR_H
+
+#include <TINYSTL/allocator.h>
+#include <TINYSTL/atomic.h>
+#include <string.h>
+
+namespace tinystl {
+
+	// Live counters for one tag. Every tracking_allocator with the same tag
+	// shares one record; records register themselves on first use.
+	struct tracking_stats {
+		size_t allocations;
+		size_t frees;
+		size_t reallocations;
+		size_t live_bytes;
+		size_t peak_bytes;
+		tracking_stats* next;
+		int registered;
+		char name[128];
+	};
+
+	// A snapshot of a tracking_stats record
+	struct tracking_counts {
+		const char* name;
+		size_t allocations;
+		size_t frees;
+		size_t reallocations;
+		size_t live_bytes;
+		size_t peak_bytes;
+	};
+
+	// Wraps a stateless allocator and counts its traffic under Tag. The tag
+	// is named by a static Tag::name() if it has one, otherwise by its type
+	// name, so the container type itself makes a convenient tag:
+	//   typedef tinystl::vector<mesh*> mesh_list;
+	//   tinystl::vector<mesh*, tinystl::tracking_allocator<mesh_list> > meshes;
+	//
+	// Recording costs a couple of relaxed atomic adds per call. Tags used
+	// from many threads at once share a cache line, so give hot per-thread
+	// containers their own tag.
+	//
+	// Blocks are tracked at the size the container asks for, so this
+	// wrapper deliberately does not forward static_allocate_at_least.
+	template<typename Tag, typename Upstream = allocator>
+	struct tracking_allocator {
+		static void* static_allocate(size_t bytes);
+		static void* static_allocate(size_t bytes, size_t alignment);
+		static void* static_reallocate(void* ptr, size_t oldbytes, size_t newbytes);
+		static void static_deallocate(void* ptr, size_t bytes);
+		static void static_deallocate(void* ptr, size_t bytes, size_t alignment);
+	};
+
+	struct tracking_registry {
+		spinlock lock;
+		tracking_stats* first;
+	};
+
+	// not static: every translation unit must share the same registry
+	inline tracking_registry* tracking_get_registry() {
+		static tracking_registry s_registry;
+		return &s_registry;
+	}
+
+	template<typename Tag>
+	struct tracking_tag {
+		static tracking_stats s_stats;
+	};
+
+	template<typename Tag>
+	tracking_stats tracking_tag<Tag>::s_stats;
+
+	static inline void tracking_copy_name(char* dest, size_t size, const char* first, const char* last) {
+		size_t length = (size_t)(last - first);
+		if (length > size - 1)
+			length = size - 1;
+		memcpy(dest, first, length);
+		dest[length] = 0;
+	}
+
+	template<typename Tag>
+	static inline const char* tracking_type_signature() {
+#if defined(_MSC_VER) && !defined(__clang__)
+		return __FUNCSIG__;
+#else
+		return __PRETTY_FUNCTION__;
+#endif
+	}
+
+	// Pulls the type out of the compiler's function signature:
+	//   gcc/clang: "... tracking_type_signature() [with Tag = foo; ...]"
+	//   msvc:      "... tracking_type_signature<struct foo>(void)"
+	static inline void tracking_parse_signature(char* dest, size_t size, const char* signature) {
+		const char* first = strstr(signature, "Tag = ");
+		if (first) {
+			first += 6;
+			const char* last = first;
+			int depth = 0;
+			for (; *last; ++last) {
+				if (*last == '<' || *last == '(' || *last == '[')
+					++depth;
+				else if (*last == '>' || *last == ')' || *last == ']') {
+					if (!depth)
+						break;
+					--depth;
+				} else if (*last == ';' && !depth)
+					break;
+			}
+			tracking_copy_name(dest, size, first, last);
+			return;
+		}
+
+		first = strstr(signature, "tracking_type_signature<");
+		const char* last = strrchr(signature, '>');
+		if (first && last && last > first) {
+			first += 24;
+			tracking_copy_name(dest, size, first, last);
+			return;
+		}
+
+		tracking_copy_name(dest, size, signature, signature + strlen(signature));
+	}
+
+	template<typename Tag>
+	static inline auto tracking_tag_name(char* dest, size_t size, int)
+		-> decltype(Tag::name(), void())
+	{
+		const char* name = Tag::name();
+		tracking_copy_name(dest, size, name, name + strlen(name));
+	}
+
+	template<typename Tag>
+	static inline void tracking_tag_name(char* dest, size_t size, ...) {
+		tracking_parse_signature(dest, size, tracking_type_signature<Tag>());
+	}
+
+	template<typename Tag>
+	static inline tracking_stats* tracking_get_stats() {
+		tracking_stats* stats = &tracking_tag<Tag>::s_stats;
+		if (atomic_load_acquire(&stats->registered))
+			return stats;
+
+		tracking_registry* registry = tracking_get_registry();
+		spinlock_lock(&registry->lock);
+		if (!stats->registered) {
+			tracking_tag_name<Tag>(stats->name, sizeof(stats->name), 0);
+			stats->next = registry->first;
+			atomic_store_release(&registry->first, stats);
+			atomic_store_release(&stats->registered, 1);
+		}
+		spinlock_unlock(&registry->lock);
+		return stats;
+	}
+
+	static inline void tracking_add_live(tracking_stats* stats, size_t delta) {
+		const size_t live = atomic_fetch_add_relaxed(&stats->live_bytes, delta) + delta;
+		size_t peak = atomic_load_relaxed(&stats->peak_bytes);
+		while (live > peak && !atomic_compare_exchange(&stats->peak_bytes, &peak, live))
+			;
+	}
+
+	static inline void tracking_record_allocate(tracking_stats* stats, size_t bytes) {
+		atomic_fetch_add_relaxed(&stats->allocations, (size_t)1);
+		tracking_add_live(stats, bytes);
+	}
+
+	static inline void tracking_record_deallocate(tracking_stats* stats, size_t bytes) {
+		atomic_fetch_add_relaxed(&stats->frees, (size_t)1);
+		atomic_fetch_add_relaxed(&stats->live_bytes, (size_t)0 - bytes);
+	}
+
+	template<typename Tag, typename Upstream>
+	inline void* tracking_allocator<Tag, Upstream>::static_allocate(size_t bytes) {
+		void* ptr = Upstream::static_allocate(bytes);
+		if (ptr)
+			tracking_record_allocate(tracking_get_stats<Tag>(), bytes);
+		return ptr;
+	}
+
+	template<typename Tag, typename Upstream>
+	inline void* tracking_allocator<Tag, Upstream>::static_allocate(size_t bytes, size_t alignment) {
+		Upstream upstream;
+		void* ptr = allocator_allocate(upstream, bytes, alignment);
+		if (ptr)
+			tracking_record_allocate(tracking_get_stats<Tag>(), bytes);
+		return ptr;
+	}
+
+	template<typename Tag, typename Upstream>
+	inline void* tracking_allocator<Tag, Upstream>::static_reallocate(void* ptr, size_t oldbytes, size_t newbytes) {
+		Upstream upstream;
+		void* newptr = allocator_reallocate(upstream, ptr, oldbytes, newbytes, c_allocator_alignment);
+		if (newptr) {
+			tracking_stats* stats = tracking_get_stats<Tag>();
+			atomic_fetch_add_relaxed(&stats->reallocations, (size_t)1);
+			tracking_add_live(stats, newbytes - oldbytes);
+		}
+		return newptr;
+	}
+
+	template<typename Tag, typename Upstream>
+	inline void tracking_allocator<Tag, Upstream>::static_deallocate(void* ptr, size_t bytes) {
+		if (!ptr)
+			return;
+		tracking_record_deallocate(tracking_get_stats<Tag>(), bytes);
+		Upstream::static_deallocate(ptr, bytes);
+	}
+
+	template<typename Tag, typename Upstream>
+	inline void tracking_allocator<Tag, Upstream>::static_deallocate(void* ptr, size_t bytes, size_t alignment) {
+		if (!ptr)
+			return;
+		tracking_record_deallocate(tracking_get_stats<Tag>(), bytes);
+		Upstream upstream;
+		allocator_deallocate(upstream, ptr, bytes, alignment);
+	}
+
+	static inline tracking_counts tracking_read_counts(const tracking_stats* stats) {
+		tracking_counts counts;
+		counts.name = stats->name;
+		counts.allocations = atomic_load_relaxed(&stats->allocations);
+		counts.frees = atomic_load_relaxed(&stats->frees);
+		counts.reallocations = atomic_load_relaxed(&stats->reallocations);
+		counts.live_bytes = atomic_load_relaxed(&stats->live_bytes);
+		counts.peak_bytes = atomic_load_relaxed(&stats->peak_bytes);
+		return counts;
+	}
+
+	template<typename Tag>
+	static inline tracking_counts tracking_tag_counts() {
+		return tracking_read_counts(tracking_get_stats<Tag>());
+	}
+
+	// Walk every tag that has allocated so far:
+	//   for (const tracking_stats* it = tracking_first_stats(); it; it = it->next)
+	static inline const tracking_stats* tracking_first_stats() {
+		return atomic_load_acquire(&tracking_get_registry()->first);
+	}
+}
+
+#endif
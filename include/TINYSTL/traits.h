@@ -40,11 +40,51 @@
 namespace tinystl {
 	template<typename T, bool pod = TINYSTL_TRY_POD_OPTIMIZATION(T)> struct pod_traits {};
 
+	template<typename T, typename U>
+	struct is_same {
+		static const bool value = false;
+	};
+
+	template<typename T>
+	struct is_same<T, T> {
+		static const bool value = true;
+	};
+
+	template<typename T>
+	struct void_type {
+		typedef void type;
+	};
+
+	template<typename T, typename = void>
+	struct relocatable_opt_in {
+		static const bool value = false;
+	};
+
+	// The typedef must name T itself: a class deriving from an opted-in
+	// type inherits the typedef but may add members that point into itself
+	template<typename T>
+	struct relocatable_opt_in<T, typename void_type<typename T::tinystl_relocatable>::type> {
+		static const bool value = is_same<T, typename T::tinystl_relocatable>::value;
+	};
+
+	// A type is trivially relocatable when moving it to a new address and
+	// forgetting the old one is the same as copying its bytes. That holds
+	// for POD types; other types opt in by inserting:
+	// typedef MyType tinystl_relocatable;
+	// in the definition of MyType, or by specializing is_trivially_relocatable.
+	// Types that point into themselves must not opt in.
+	template<typename T>
+	struct is_trivially_relocatable {
+		static const bool value = TINYSTL_TRY_POD_OPTIMIZATION(T) || relocatable_opt_in<T>::value;
+	};
+
+	template<typename T, bool relocatable = is_trivially_relocatable<T>::value> struct relocatable_traits {};
+
 	template<typename T, T t> struct swap_holder;
 
 	template<typename T>
 	static inline void move_impl(T& a, T& b, ...) {
-		a = b;
+		a = static_cast<T&&>(b);
 	}
 
 	template<typename T>
@@ -71,6 +111,16 @@ namespace tinystl {
 		a->swap(b);
 	}
 
+	// Preferred whenever T can be constructed from an rvalue. Note that a
+	// type with a copy constructor but no move constructor lands here too
+	// and is copied; give it a move constructor.
+	template<typename T>
+	static inline auto move_construct_impl(T* a, T& b, const T*)
+		-> decltype(new(placeholder(), a) T(static_cast<T&&>(b)), void())
+	{
+		new(placeholder(), a) T(static_cast<T&&>(b));
+	}
+
 	template<typename T>
 	static inline void move_construct_impl(T* a, T& b, T*, typename T::tinystl_nomove_construct* = 0) {
 		new(placeholder(), a) T(b);
@@ -38,6 +38,7 @@ namespace tinystl {
 	class unordered_map {
 	public:
 		unordered_map();
+		explicit unordered_map(const Alloc& alloc);
 		unordered_map(const unordered_map& other);
 		unordered_map(unordered_map&& other);
 		~unordered_map();
@@ -45,6 +46,8 @@ namespace tinystl {
 		unordered_map& operator=(const unordered_map& other);
 		unordered_map& operator=(unordered_map&& other);
 
+		const Alloc& get_allocator() const;
+
 		typedef pair<Key, Value> value_type;
 
 		typedef unordered_hash_iterator<const unordered_hash_node<Key, Value> > const_iterator;
@@ -78,6 +81,12 @@ namespace tinystl {
 
 		size_t m_size;
 		tinystl::buffer<pointer, Alloc> m_buckets;
+		unordered_hash_node_pool<unordered_hash_node<Key, Value> > m_nodes;
+	};
+
+	template<typename Key, typename Value, typename Alloc>
+	struct is_trivially_relocatable<unordered_map<Key, Value, Alloc> > {
+		static const bool value = is_trivially_relocatable<Alloc>::value;
 	};
 
 	template<typename Key, typename Value, typename Alloc>
@@ -85,18 +94,30 @@ namespace tinystl {
 		: m_size(0)
 	{
 		buffer_init<pointer, Alloc>(&m_buckets);
+		unordered_hash_pool_init(&m_nodes);
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline unordered_map<Key, Value, Alloc>::unordered_map(const Alloc& alloc)
+		: m_size(0)
+		, m_buckets(alloc)
+	{
+		buffer_init<pointer, Alloc>(&m_buckets);
+		unordered_hash_pool_init(&m_nodes);
 	}
 
 	template<typename Key, typename Value, typename Alloc>
 	inline unordered_map<Key, Value, Alloc>::unordered_map(const unordered_map& other)
 		: m_size(other.m_size)
+		, m_buckets(other.get_allocator())
 	{
 		const size_t nbuckets = (size_t)(other.m_buckets.last - other.m_buckets.first);
 		buffer_init<pointer, Alloc>(&m_buckets);
+		unordered_hash_pool_init(&m_nodes);
 		buffer_resize<pointer, Alloc>(&m_buckets, nbuckets, 0);
 
 		for (pointer it = *other.m_buckets.first; it; it = it->next) {
-			unordered_hash_node<Key, Value>* newnode = new(placeholder(), Alloc::static_allocate(sizeof(unordered_hash_node<Key, Value>))) unordered_hash_node<Key, Value>(it->first, it->second);
+			unordered_hash_node<Key, Value>* newnode = new(placeholder(), unordered_hash_pool_allocate(&m_nodes, m_buckets)) unordered_hash_node<Key, Value>(it->first, it->second);
 			newnode->next = newnode->prev = 0;
 
 			unordered_hash_node_insert(newnode, hash(it->first), m_buckets.first, nbuckets - 1);
@@ -106,8 +127,10 @@ namespace tinystl {
 	template<typename Key, typename Value, typename Alloc>
 	inline unordered_map<Key, Value, Alloc>::unordered_map(unordered_map&& other)
 		: m_size(other.m_size)
+		, m_buckets(other.get_allocator())
 	{
 		buffer_move(&m_buckets, &other.m_buckets);
+		unordered_hash_pool_move(&m_nodes, &other.m_nodes);
 		other.m_size = 0;
 	}
 
@@ -115,6 +138,7 @@ namespace tinystl {
 	inline unordered_map<Key, Value, Alloc>::~unordered_map() {
 		if (m_buckets.first != m_buckets.last)
 			clear();
+		unordered_hash_pool_destroy(&m_nodes, m_buckets);
 		buffer_destroy<pointer, Alloc>(&m_buckets);
 	}
 
@@ -130,6 +154,11 @@ namespace tinystl {
 		return *this;
 	}
 
+	template<typename Key, typename Value, typename Alloc>
+	inline const Alloc& unordered_map<Key, Value, Alloc>::get_allocator() const {
+		return m_buckets;
+	}
+
 	template<typename Key, typename Value, typename Alloc>
 	inline typename unordered_map<Key, Value, Alloc>::iterator unordered_map<Key, Value, Alloc>::begin() {
 		iterator it;
@@ -174,11 +203,11 @@ namespace tinystl {
 		while (it) {
 			const pointer next = it->next;
 			it->~unordered_hash_node<Key, Value>();
-			Alloc::static_deallocate(it, sizeof(unordered_hash_node<Key, Value>));
-
 			it = next;
 		}
 
+		unordered_hash_pool_destroy(&m_nodes, m_buckets);
+
 		m_buckets.last = m_buckets.first;
 		buffer_resize<pointer, Alloc>(&m_buckets, 9, 0);
 		m_size = 0;
@@ -226,7 +255,7 @@ namespace tinystl {
 		if (result.first.node != 0)
 			return result;
 
-		unordered_hash_node<Key, Value>* newnode = new(placeholder(), Alloc::static_allocate(sizeof(unordered_hash_node<Key, Value>))) unordered_hash_node<Key, Value>(p.first, p.second);
+		unordered_hash_node<Key, Value>* newnode = new(placeholder(), unordered_hash_pool_allocate(&m_nodes, m_buckets)) unordered_hash_node<Key, Value>(p.first, p.second);
 		newnode->next = newnode->prev = 0;
 
 		if(!m_buckets.first) buffer_resize<pointer, Alloc>(&m_buckets, 9, 0);
@@ -251,7 +280,7 @@ namespace tinystl {
 			return result;
 
 		const size_t keyhash = hash(p.first);
-		unordered_hash_node<Key, Value>* newnode = new(placeholder(), Alloc::static_allocate(sizeof(unordered_hash_node<Key, Value>))) unordered_hash_node<Key, Value>(static_cast<Key&&>(p.first), static_cast<Value&&>(p.second));
+		unordered_hash_node<Key, Value>* newnode = new(placeholder(), unordered_hash_pool_allocate(&m_nodes, m_buckets)) unordered_hash_node<Key, Value>(static_cast<Key&&>(p.first), static_cast<Value&&>(p.second));
 		newnode->next = newnode->prev = 0;
 
 		if (!m_buckets.first) buffer_resize<pointer, Alloc>(&m_buckets, 9, 0);
@@ -271,7 +300,7 @@ namespace tinystl {
 		unordered_hash_node_erase(where.node, hash(where->first), m_buckets.first, (size_t)(m_buckets.last - m_buckets.first) - 1);
 
 		where->~unordered_hash_node<Key, Value>();
-		Alloc::static_deallocate((void*)where.node, sizeof(unordered_hash_node<Key, Value>));
+		unordered_hash_pool_deallocate(&m_nodes, (void*)where.node);
 		--m_size;
 	}
 
@@ -285,6 +314,7 @@ namespace tinystl {
 		size_t tsize = other.m_size;
 		other.m_size = m_size, m_size = tsize;
 		buffer_swap(&m_buckets, &other.m_buckets);
+		unordered_hash_pool_swap(&m_nodes, &other.m_nodes);
 	}
 }
 #endif
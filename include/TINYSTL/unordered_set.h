@@ -38,6 +38,7 @@ namespace tinystl {
 	class unordered_set {
 	public:
 		unordered_set();
+		explicit unordered_set(const Alloc& alloc);
 		unordered_set(const unordered_set& other);
 		unordered_set(unordered_set&& other);
 		~unordered_set();
@@ -45,6 +46,8 @@ namespace tinystl {
 		unordered_set& operator=(const unordered_set& other);
 		unordered_set& operator=(unordered_set&& other);
 
+		const Alloc& get_allocator() const;
+
 		typedef unordered_hash_iterator<const unordered_hash_node<Key, void> > const_iterator;
 		typedef const_iterator iterator;
 
@@ -71,6 +74,12 @@ namespace tinystl {
 
 		size_t m_size;
 		tinystl::buffer<pointer, Alloc> m_buckets;
+		unordered_hash_node_pool<unordered_hash_node<Key, void> > m_nodes;
+	};
+
+	template<typename Key, typename Alloc>
+	struct is_trivially_relocatable<unordered_set<Key, Alloc> > {
+		static const bool value = is_trivially_relocatable<Alloc>::value;
 	};
 
 	template<typename Key, typename Alloc>
@@ -78,19 +87,32 @@ namespace tinystl {
 		: m_size(0)
 	{
 		buffer_init<pointer, Alloc>(&m_buckets);
+		unordered_hash_pool_init(&m_nodes);
+		buffer_resize<pointer, Alloc>(&m_buckets, 9, 0);
+	}
+
+	template<typename Key, typename Alloc>
+	inline unordered_set<Key, Alloc>::unordered_set(const Alloc& alloc)
+		: m_size(0)
+		, m_buckets(alloc)
+	{
+		buffer_init<pointer, Alloc>(&m_buckets);
+		unordered_hash_pool_init(&m_nodes);
 		buffer_resize<pointer, Alloc>(&m_buckets, 9, 0);
 	}
 
 	template<typename Key, typename Alloc>
 	inline unordered_set<Key, Alloc>::unordered_set(const unordered_set& other)
 		: m_size(other.m_size)
+		, m_buckets(other.get_allocator())
 	{
 		const size_t nbuckets = (size_t)(other.m_buckets.last - other.m_buckets.first);
 		buffer_init<pointer, Alloc>(&m_buckets);
+		unordered_hash_pool_init(&m_nodes);
 		buffer_resize<pointer, Alloc>(&m_buckets, nbuckets, 0);
 
 		for (pointer it = *other.m_buckets.first; it; it = it->next) {
-			unordered_hash_node<Key, void>* newnode = new(placeholder(), Alloc::static_allocate(sizeof(unordered_hash_node<Key, void>))) unordered_hash_node<Key, void>(*it);
+			unordered_hash_node<Key, void>* newnode = new(placeholder(), unordered_hash_pool_allocate(&m_nodes, m_buckets)) unordered_hash_node<Key, void>(it->first);
 			newnode->next = newnode->prev = 0;
 			unordered_hash_node_insert(newnode, hash(it->first), m_buckets.first, nbuckets - 1);
 		}
@@ -99,8 +121,10 @@ namespace tinystl {
 	template<typename Key, typename Alloc>
 	inline unordered_set<Key, Alloc>::unordered_set(unordered_set&& other)
 		: m_size(other.m_size)
+		, m_buckets(other.get_allocator())
 	{
 		buffer_move(&m_buckets, &other.m_buckets);
+		unordered_hash_pool_move(&m_nodes, &other.m_nodes);
 		other.m_size = 0;
 	}
 
@@ -108,6 +132,7 @@ namespace tinystl {
 	inline unordered_set<Key, Alloc>::~unordered_set() {
 		if (m_buckets.first != m_buckets.last)
 			clear();
+		unordered_hash_pool_destroy(&m_nodes, m_buckets);
 		buffer_destroy<pointer, Alloc>(&m_buckets);
 	}
 
@@ -123,6 +148,11 @@ namespace tinystl {
 		return *this;
 	}
 
+	template<typename Key, typename Alloc>
+	inline const Alloc& unordered_set<Key, Alloc>::get_allocator() const {
+		return m_buckets;
+	}
+
 	template<typename Key, typename Alloc>
 	inline typename unordered_set<Key, Alloc>::iterator unordered_set<Key, Alloc>::begin() const {
 		iterator cit;
@@ -153,11 +183,11 @@ namespace tinystl {
 		while (it) {
 			const pointer next = it->next;
 			it->~unordered_hash_node<Key, void>();
-			Alloc::static_deallocate(it, sizeof(unordered_hash_node<Key, void>));
-
 			it = next;
 		}
 
+		unordered_hash_pool_destroy(&m_nodes, m_buckets);
+
 		m_buckets.last = m_buckets.first;
 		buffer_resize<pointer, Alloc>(&m_buckets, 9, 0);
 		m_size = 0;
@@ -198,7 +228,7 @@ namespace tinystl {
 		if (result.first.node != 0)
 			return result;
 
-		unordered_hash_node<Key, void>* newnode = new(placeholder(), Alloc::static_allocate(sizeof(unordered_hash_node<Key, void>))) unordered_hash_node<Key, void>(key);
+		unordered_hash_node<Key, void>* newnode = new(placeholder(), unordered_hash_pool_allocate(&m_nodes, m_buckets)) unordered_hash_node<Key, void>(key);
 		newnode->next = newnode->prev = 0;
 
 		const size_t nbuckets = (size_t)(m_buckets.last - m_buckets.first);
@@ -222,7 +252,7 @@ namespace tinystl {
 			return result;
 
 		const size_t keyhash = hash(key);
-		unordered_hash_node<Key, void>* newnode = new(placeholder(), Alloc::static_allocate(sizeof(unordered_hash_node<Key, void>))) unordered_hash_node<Key, void>(static_cast<Key&&>(key));
+		unordered_hash_node<Key, void>* newnode = new(placeholder(), unordered_hash_pool_allocate(&m_nodes, m_buckets)) unordered_hash_node<Key, void>(static_cast<Key&&>(key));
 		newnode->next = newnode->prev = 0;
 
 		const size_t nbuckets = (size_t)(m_buckets.last - m_buckets.first);
@@ -241,7 +271,7 @@ namespace tinystl {
 		unordered_hash_node_erase(where.node, hash(where.node->first), m_buckets.first, (size_t)(m_buckets.last - m_buckets.first) - 1);
 
 		where.node->~unordered_hash_node<Key, void>();
-		Alloc::static_deallocate((void*)where.node, sizeof(unordered_hash_node<Key, void>));
+		unordered_hash_pool_deallocate(&m_nodes, (void*)where.node);
 		--m_size;
 	}
 
@@ -260,6 +290,7 @@ namespace tinystl {
 		size_t tsize = other.m_size;
 		other.m_size = m_size, m_size = tsize;
 		buffer_swap(&m_buckets, &other.m_buckets);
+		unordered_hash_pool_swap(&m_nodes, &other.m_nodes);
 	}
 }
 #endif
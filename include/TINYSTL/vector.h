@@ -37,11 +37,15 @@ namespace tinystl {
 	class vector {
 	public:
 		vector();
+		explicit vector(const Alloc& alloc);
 		vector(const vector& other);
 		vector(vector&& other);
 		vector(size_t size);
 		vector(size_t size, const T& value);
 		vector(const T* first, const T* last);
+		vector(size_t size, const Alloc& alloc);
+		vector(size_t size, const T& value, const Alloc& alloc);
+		vector(const T* first, const T* last, const Alloc& alloc);
 		~vector();
 
 		vector& operator=(const vector& other);
@@ -49,6 +53,8 @@ namespace tinystl {
 
 		void assign(const T* first, const T* last);
 
+		const Alloc& get_allocator() const;
+
 		const T* data() const;
 		T* data();
 		size_t size() const;
@@ -65,15 +71,16 @@ namespace tinystl {
 
 		void resize(size_t size);
 		void resize(size_t size, const T& value);
+		void resize_uninitialized(size_t size);
 		void clear();
 		void reserve(size_t capacity);
 
 		void push_back(const T& t);
+		void push_back(T&& t);
 		void pop_back();
 
-		void emplace_back();
-		template<typename Param>
-		void emplace_back(const Param& param);
+		template<typename... Args>
+		void emplace_back(Args&&... args);
 
 		void shrink_to_fit();
 
@@ -91,10 +98,11 @@ namespace tinystl {
 
 		void insert(iterator where);
 		void insert(iterator where, const T& value);
+		void insert(iterator where, T&& value);
 		void insert(iterator where, const T* first, const T* last);
 
-		template<typename Param>
-		void emplace(iterator where, const Param& param);
+		template<typename... Args>
+		void emplace(iterator where, Args&&... args);
 
 		iterator erase(iterator where);
 		iterator erase(iterator first, iterator last);
@@ -106,20 +114,37 @@ namespace tinystl {
 		buffer<T, Alloc> m_buffer;
 	};
 
+	// a vector only points at its heap block, so it moves with its allocator
+	template<typename T, typename Alloc>
+	struct is_trivially_relocatable<vector<T, Alloc> > {
+		static const bool value = is_trivially_relocatable<Alloc>::value;
+	};
+
 	template<typename T, typename Alloc>
 	inline vector<T, Alloc>::vector() {
 		buffer_init(&m_buffer);
 	}
 
 	template<typename T, typename Alloc>
-	inline vector<T, Alloc>::vector(const vector& other) {
+	inline vector<T, Alloc>::vector(const Alloc& alloc)
+		: m_buffer(alloc)
+	{
+		buffer_init(&m_buffer);
+	}
+
+	template<typename T, typename Alloc>
+	inline vector<T, Alloc>::vector(const vector& other)
+		: m_buffer(other.get_allocator())
+	{
 		buffer_init(&m_buffer);
 		buffer_reserve(&m_buffer, other.size());
 		buffer_insert(&m_buffer, m_buffer.last, other.m_buffer.first, other.m_buffer.last);
 	}
 
 	template<typename T, typename Alloc>
-	inline vector<T, Alloc>::vector(vector&& other) {
+	inline vector<T, Alloc>::vector(vector&& other)
+		: m_buffer(other.get_allocator())
+	{
 		buffer_move(&m_buffer, &other.m_buffer);
 	}
 
@@ -141,6 +166,30 @@ namespace tinystl {
 		buffer_insert(&m_buffer, m_buffer.last, first, last);
 	}
 
+	template<typename T, typename Alloc>
+	inline vector<T, Alloc>::vector(size_t size, const Alloc& alloc)
+		: m_buffer(alloc)
+	{
+		buffer_init(&m_buffer);
+		buffer_resize(&m_buffer, size);
+	}
+
+	template<typename T, typename Alloc>
+	inline vector<T, Alloc>::vector(size_t size, const T& value, const Alloc& alloc)
+		: m_buffer(alloc)
+	{
+		buffer_init(&m_buffer);
+		buffer_resize(&m_buffer, size, value);
+	}
+
+	template<typename T, typename Alloc>
+	inline vector<T, Alloc>::vector(const T* first, const T* last, const Alloc& alloc)
+		: m_buffer(alloc)
+	{
+		buffer_init(&m_buffer);
+		buffer_insert(&m_buffer, m_buffer.last, first, last);
+	}
+
 	template<typename T, typename Alloc>
 	inline vector<T, Alloc>::~vector() {
 		buffer_destroy(&m_buffer);
@@ -165,6 +214,11 @@ namespace tinystl {
 		buffer_insert(&m_buffer, m_buffer.last, first, last);
 	}
 
+	template<typename T, typename Alloc>
+	inline const Alloc& vector<T, Alloc>::get_allocator() const {
+		return m_buffer;
+	}
+
 	template<typename T, typename Alloc>
 	inline const T* vector<T, Alloc>::data() const {
 		return m_buffer.first;
@@ -230,6 +284,13 @@ namespace tinystl {
 		buffer_resize(&m_buffer, size, value);
 	}
 
+	// New elements are default-initialized, so POD elements are left
+	// uninitialized for the caller to overwrite
+	template<typename T, typename Alloc>
+	inline void vector<T, Alloc>::resize_uninitialized(size_t size) {
+		buffer_resize_uninitialized(&m_buffer, size);
+	}
+
 	template<typename T, typename Alloc>
 	inline void vector<T, Alloc>::clear() {
 		buffer_clear(&m_buffer);
@@ -246,14 +307,14 @@ namespace tinystl {
 	}
 
 	template<typename T, typename Alloc>
-	inline void vector<T, Alloc>::emplace_back() {
-		buffer_append(&m_buffer);
+	inline void vector<T, Alloc>::push_back(T&& t) {
+		buffer_emplace(&m_buffer, m_buffer.last, static_cast<T&&>(t));
 	}
 
 	template<typename T, typename Alloc>
-	template<typename Param>
-	inline void vector<T, Alloc>::emplace_back(const Param& param) {
-		buffer_append(&m_buffer, &param);
+	template<typename... Args>
+	inline void vector<T, Alloc>::emplace_back(Args&&... args) {
+		buffer_emplace(&m_buffer, m_buffer.last, static_cast<Args&&>(args)...);
 	}
 
 	template<typename T, typename Alloc>
@@ -301,6 +362,11 @@ namespace tinystl {
 		buffer_insert(&m_buffer, where, &value, &value + 1);
 	}
 
+	template<typename T, typename Alloc>
+	inline void vector<T, Alloc>::insert(iterator where, T&& value) {
+		buffer_emplace(&m_buffer, where, static_cast<T&&>(value));
+	}
+
 	template<typename T, typename Alloc>
 	inline void vector<T, Alloc>::insert(iterator where, const T* first, const T* last) {
 		buffer_insert(&m_buffer, where, first, last);
@@ -327,9 +393,9 @@ namespace tinystl {
 	}
 
 	template<typename T, typename Alloc>
-	template<typename Param>
-	void vector<T, Alloc>::emplace(typename vector::iterator where, const Param& param) {
-		buffer_insert(&m_buffer, where, &param, &param + 1);
+	template<typename... Args>
+	void vector<T, Alloc>::emplace(typename vector::iterator where, Args&&... args) {
+		buffer_emplace(&m_buffer, where, static_cast<Args&&>(args)...);
 	}
 }
 
@@ -0,0 +1,597 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TINYSTL_VM_VECTOR_H
+#define TINYSTL_VM_VECTOR_H
+
+#include <TINYSTL/buffer.h>
+#include <TINYSTL/new.h>
+#include <TINYSTL/stddef.h>
+#include <TINYSTL/traits.h>
+#include <stdlib.h>
+
+#if defined(_WIN32)
+#	include <windows.h>
+#else
+#	include <sys/mman.h>
+#	include <unistd.h>
+#endif
+
+// Address space reserved by a default-constructed vm_vector
+#ifndef TINYSTL_VM_VECTOR_RESERVE
+#	define TINYSTL_VM_VECTOR_RESERVE ((size_t)1 << (sizeof(void*) == 8 ? 36 : 28))
+#endif
+
+namespace tinystl {
+
+#if defined(_WIN32)
+	static inline size_t vm_page_size() {
+		SYSTEM_INFO info;
+		GetSystemInfo(&info);
+		return info.dwPageSize;
+	}
+
+	static inline void* vm_reserve(size_t bytes) {
+		return VirtualAlloc(0, bytes, MEM_RESERVE, PAGE_NOACCESS);
+	}
+
+	static inline bool vm_commit(void* ptr, size_t bytes) {
+		return 0 != VirtualAlloc(ptr, bytes, MEM_COMMIT, PAGE_READWRITE);
+	}
+
+	static inline void vm_decommit(void* ptr, size_t bytes) {
+		VirtualFree(ptr, bytes, MEM_DECOMMIT);
+	}
+
+	static inline void vm_release(void* ptr, size_t) {
+		VirtualFree(ptr, 0, MEM_RELEASE);
+	}
+#else
+	static inline size_t vm_page_size() {
+		return (size_t)sysconf(_SC_PAGESIZE);
+	}
+
+	static inline void* vm_reserve(size_t bytes) {
+		int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#	if defined(MAP_NORESERVE)
+		flags |= MAP_NORESERVE;
+#	endif
+		void* ptr = mmap(0, bytes, PROT_NONE, flags, -1, 0);
+		return (ptr == MAP_FAILED) ? 0 : ptr;
+	}
+
+	static inline bool vm_commit(void* ptr, size_t bytes) {
+		return 0 == mprotect(ptr, bytes, PROT_READ | PROT_WRITE);
+	}
+
+	// drop the pages first so the kernel frees them, then fence them off again
+	static inline void vm_decommit(void* ptr, size_t bytes) {
+		madvise(ptr, bytes, MADV_DONTNEED);
+		mprotect(ptr, bytes, PROT_NONE);
+	}
+
+	static inline void vm_release(void* ptr, size_t bytes) {
+		munmap(ptr, bytes);
+	}
+#endif
+
+	struct vm_reservation {
+		explicit vm_reservation(size_t bytes) : bytes(bytes) {}
+		size_t bytes;
+	};
+
+	// A vector backed by a private range of reserved address space. Pages are
+	// committed as the vector grows, so growth never copies and data() never
+	// changes once the first element is added. shrink_to_fit hands pages past
+	// the end back to the OS.
+	//
+	// The range is reserved on first growth; TINYSTL_VM_VECTOR_RESERVE bytes
+	// unless a vm_reservation is given. Growing past max_size() aborts.
+	template<typename T>
+	class vm_vector {
+	public:
+		vm_vector();
+		explicit vm_vector(vm_reservation reservation);
+		vm_vector(const vm_vector& other);
+		vm_vector(vm_vector&& other);
+		vm_vector(size_t size);
+		vm_vector(size_t size, const T& value);
+		vm_vector(const T* first, const T* last);
+		~vm_vector();
+
+		vm_vector& operator=(const vm_vector& other);
+		vm_vector& operator=(vm_vector&& other);
+
+		void assign(const T* first, const T* last);
+
+		const T* data() const;
+		T* data();
+		size_t size() const;
+		size_t capacity() const;
+		size_t max_size() const;
+		bool empty() const;
+
+		T& operator[](size_t idx);
+		const T& operator[](size_t idx) const;
+
+		const T& front() const;
+		T& front();
+		const T& back() const;
+		T& back();
+
+		void resize(size_t size);
+		void resize(size_t size, const T& value);
+		void resize_uninitialized(size_t size);
+		void clear();
+		void reserve(size_t capacity);
+
+		void push_back(const T& t);
+		void push_back(T&& t);
+		void pop_back();
+
+		template<typename... Args>
+		void emplace_back(Args&&... args);
+
+		void shrink_to_fit();
+
+		void swap(vm_vector& other);
+
+		typedef T value_type;
+
+		typedef T* iterator;
+		iterator begin();
+		iterator end();
+
+		typedef const T* const_iterator;
+		const_iterator begin() const;
+		const_iterator end() const;
+
+		void insert(iterator where);
+		void insert(iterator where, const T& value);
+		void insert(iterator where, T&& value);
+		void insert(iterator where, const T* first, const T* last);
+
+		template<typename... Args>
+		void emplace(iterator where, Args&&... args);
+
+		iterator erase(iterator where);
+		iterator erase(iterator first, iterator last);
+
+		iterator erase_unordered(iterator where);
+		iterator erase_unordered(iterator first, iterator last);
+
+	private:
+		void commit(size_t capacity);
+		T* insert_common(T* where, size_t count);
+		void release();
+
+		T* m_first;
+		T* m_last;
+		T* m_capacity;
+		size_t m_committed;
+		size_t m_reserved;
+	};
+
+	// nothing points back into the object, only into the mapping
+	template<typename T>
+	struct is_trivially_relocatable<vm_vector<T> > {
+		static const bool value = true;
+	};
+
+	template<typename T>
+	inline vm_vector<T>::vm_vector()
+		: m_first(0)
+		, m_last(0)
+		, m_capacity(0)
+		, m_committed(0)
+		, m_reserved(TINYSTL_VM_VECTOR_RESERVE)
+	{
+	}
+
+	template<typename T>
+	inline vm_vector<T>::vm_vector(vm_reservation reservation)
+		: m_first(0)
+		, m_last(0)
+		, m_capacity(0)
+		, m_committed(0)
+		, m_reserved(reservation.bytes)
+	{
+	}
+
+	template<typename T>
+	inline vm_vector<T>::vm_vector(const vm_vector& other)
+		: m_first(0)
+		, m_last(0)
+		, m_capacity(0)
+		, m_committed(0)
+		, m_reserved(other.m_reserved)
+	{
+		insert(end(), other.begin(), other.end());
+	}
+
+	template<typename T>
+	inline vm_vector<T>::vm_vector(vm_vector&& other)
+		: m_first(other.m_first)
+		, m_last(other.m_last)
+		, m_capacity(other.m_capacity)
+		, m_committed(other.m_committed)
+		, m_reserved(other.m_reserved)
+	{
+		other.m_first = other.m_last = other.m_capacity = 0;
+		other.m_committed = 0;
+	}
+
+	template<typename T>
+	inline vm_vector<T>::vm_vector(size_t size)
+		: m_first(0)
+		, m_last(0)
+		, m_capacity(0)
+		, m_committed(0)
+		, m_reserved(TINYSTL_VM_VECTOR_RESERVE)
+	{
+		resize(size);
+	}
+
+	template<typename T>
+	inline vm_vector<T>::vm_vector(size_t size, const T& value)
+		: m_first(0)
+		, m_last(0)
+		, m_capacity(0)
+		, m_committed(0)
+		, m_reserved(TINYSTL_VM_VECTOR_RESERVE)
+	{
+		resize(size, value);
+	}
+
+	template<typename T>
+	inline vm_vector<T>::vm_vector(const T* first, const T* last)
+		: m_first(0)
+		, m_last(0)
+		, m_capacity(0)
+		, m_committed(0)
+		, m_reserved(TINYSTL_VM_VECTOR_RESERVE)
+	{
+		insert(end(), first, last);
+	}
+
+	template<typename T>
+	inline vm_vector<T>::~vm_vector() {
+		release();
+	}
+
+	template<typename T>
+	inline vm_vector<T>& vm_vector<T>::operator=(const vm_vector& other) {
+		vm_vector(other).swap(*this);
+		return *this;
+	}
+
+	template<typename T>
+	inline vm_vector<T>& vm_vector<T>::operator=(vm_vector&& other) {
+		release();
+		m_first = other.m_first, m_last = other.m_last, m_capacity = other.m_capacity;
+		m_committed = other.m_committed, m_reserved = other.m_reserved;
+		other.m_first = other.m_last = other.m_capacity = 0;
+		other.m_committed = 0;
+		return *this;
+	}
+
+	template<typename T>
+	inline void vm_vector<T>::release() {
+		buffer_destroy_range(m_first, m_last);
+		if (m_first)
+			vm_release(m_first, m_reserved);
+		m_first = m_last = m_capacity = 0;
+		m_committed = 0;
+	}
+
+	// Commits pages until capacity elements fit. The committed range at
+	// least doubles so the number of protection changes stays logarithmic.
+	template<typename T>
+	inline void vm_vector<T>::commit(size_t capacity) {
+		if ((size_t)(m_capacity - m_first) >= capacity)
+			return;
+
+		const size_t page = vm_page_size();
+		if (!m_first) {
+			m_reserved = (m_reserved + page - 1) & ~(page - 1);
+			m_first = m_last = m_capacity = (T*)vm_reserve(m_reserved);
+			m_committed = 0;
+			if (!m_first)
+				abort();
+		}
+
+		size_t bytes = sizeof(T) * capacity;
+		if (bytes < m_committed * 2)
+			bytes = m_committed * 2;
+		if (bytes < 16 * page)
+			bytes = 16 * page;
+		bytes = (bytes + page - 1) & ~(page - 1);
+		if (bytes > m_reserved)
+			bytes = m_reserved;
+
+		if (sizeof(T) * capacity > bytes || !vm_commit((char*)m_first + m_committed, bytes - m_committed))
+			abort();
+		m_committed = bytes;
+		m_capacity = m_first + bytes / sizeof(T);
+	}
+
+	template<typename T>
+	inline void vm_vector<T>::assign(const T* first, const T* last) {
+		clear();
+		insert(end(), first, last);
+	}
+
+	template<typename T>
+	inline const T* vm_vector<T>::data() const {
+		return m_first;
+	}
+
+	template<typename T>
+	inline T* vm_vector<T>::data() {
+		return m_first;
+	}
+
+	template<typename T>
+	inline size_t vm_vector<T>::size() const {
+		return (size_t)(m_last - m_first);
+	}
+
+	template<typename T>
+	inline size_t vm_vector<T>::capacity() const {
+		return (size_t)(m_capacity - m_first);
+	}
+
+	template<typename T>
+	inline size_t vm_vector<T>::max_size() const {
+		return m_reserved / sizeof(T);
+	}
+
+	template<typename T>
+	inline bool vm_vector<T>::empty() const {
+		return m_last == m_first;
+	}
+
+	template<typename T>
+	inline T& vm_vector<T>::operator[](size_t idx) {
+		return m_first[idx];
+	}
+
+	template<typename T>
+	inline const T& vm_vector<T>::operator[](size_t idx) const {
+		return m_first[idx];
+	}
+
+	template<typename T>
+	inline const T& vm_vector<T>::front() const {
+		return m_first[0];
+	}
+
+	template<typename T>
+	inline T& vm_vector<T>::front() {
+		return m_first[0];
+	}
+
+	template<typename T>
+	inline const T& vm_vector<T>::back() const {
+		return m_last[-1];
+	}
+
+	template<typename T>
+	inline T& vm_vector<T>::back() {
+		return m_last[-1];
+	}
+
+	template<typename T>
+	inline void vm_vector<T>::resize(size_t size) {
+		commit(size);
+		buffer_fill_urange(m_last, m_first + size);
+		buffer_destroy_range(m_first + size, m_last);
+		m_last = m_first + size;
+	}
+
+	template<typename T>
+	inline void vm_vector<T>::resize(size_t size, const T& value) {
+		commit(size);
+		buffer_fill_urange(m_last, m_first + size, value);
+		buffer_destroy_range(m_first + size, m_last);
+		m_last = m_first + size;
+	}
+
+	template<typename T>
+	inline void vm_vector<T>::resize_uninitialized(size_t size) {
+		commit(size);
+		buffer_default_urange(m_last, m_first + size);
+		buffer_destroy_range(m_first + size, m_last);
+		m_last = m_first + size;
+	}
+
+	template<typename T>
+	inline void vm_vector<T>::clear() {
+		buffer_destroy_range(m_first, m_last);
+		m_last = m_first;
+	}
+
+	template<typename T>
+	inline void vm_vector<T>::reserve(size_t capacity) {
+		commit(capacity);
+	}
+
+	template<typename T>
+	inline void vm_vector<T>::push_back(const T& t) {
+		// committing never moves elements, so t stays valid
+		if (m_last == m_capacity)
+			commit(size() + 1);
+		new(placeholder(), m_last) T(t);
+		++m_last;
+	}
+
+	template<typename T>
+	inline void vm_vector<T>::push_back(T&& t) {
+		if (m_last == m_capacity)
+			commit(size() + 1);
+		new(placeholder(), m_last) T(static_cast<T&&>(t));
+		++m_last;
+	}
+
+	template<typename T>
+	template<typename... Args>
+	inline void vm_vector<T>::emplace_back(Args&&... args) {
+		if (m_last == m_capacity)
+			commit(size() + 1);
+		new(placeholder(), m_last) T(static_cast<Args&&>(args)...);
+		++m_last;
+	}
+
+	template<typename T>
+	inline void vm_vector<T>::pop_back() {
+		--m_last;
+		m_last->~T();
+	}
+
+	// Returns whole pages past the last element to the OS
+	template<typename T>
+	inline void vm_vector<T>::shrink_to_fit() {
+		const size_t page = vm_page_size();
+		const size_t used = ((size_t)((char*)m_last - (char*)m_first) + page - 1) & ~(page - 1);
+		if (used < m_committed) {
+			vm_decommit((char*)m_first + used, m_committed - used);
+			m_committed = used;
+			m_capacity = m_first + used / sizeof(T);
+		}
+	}
+
+	template<typename T>
+	inline void vm_vector<T>::swap(vm_vector& other) {
+		T* const tfirst = m_first, *const tlast = m_last, *const tcapacity = m_capacity;
+		const size_t tcommitted = m_committed, treserved = m_reserved;
+		m_first = other.m_first, m_last = other.m_last, m_capacity = other.m_capacity;
+		m_committed = other.m_committed, m_reserved = other.m_reserved;
+		other.m_first = tfirst, other.m_last = tlast, other.m_capacity = tcapacity;
+		other.m_committed = tcommitted, other.m_reserved = treserved;
+	}
+
+	template<typename T>
+	inline typename vm_vector<T>::iterator vm_vector<T>::begin() {
+		return m_first;
+	}
+
+	template<typename T>
+	inline typename vm_vector<T>::iterator vm_vector<T>::end() {
+		return m_last;
+	}
+
+	template<typename T>
+	inline typename vm_vector<T>::const_iterator vm_vector<T>::begin() const {
+		return m_first;
+	}
+
+	template<typename T>
+	inline typename vm_vector<T>::const_iterator vm_vector<T>::end() const {
+		return m_last;
+	}
+
+	template<typename T>
+	inline T* vm_vector<T>::insert_common(T* where, size_t count) {
+		const size_t offset = (size_t)(where - m_first);
+		commit(size() + count);
+		where = m_first + offset;
+
+		if (where != m_last)
+			buffer_bmove_urange(where + count, where, m_last);
+		m_last += count;
+		return where;
+	}
+
+	template<typename T>
+	inline void vm_vector<T>::insert(iterator where) {
+		where = insert_common(where, 1);
+		new(placeholder(), where) T();
+	}
+
+	template<typename T>
+	inline void vm_vector<T>::insert(iterator where, const T& value) {
+		insert(where, &value, &value + 1);
+	}
+
+	template<typename T>
+	inline void vm_vector<T>::insert(iterator where, T&& value) {
+		emplace(where, static_cast<T&&>(value));
+	}
+
+	template<typename T>
+	inline void vm_vector<T>::insert(iterator where, const T* first, const T* last) {
+		const size_t count = (size_t)(last - first);
+		const bool shifted = (first >= where && first < m_last);
+		where = insert_common(where, count);
+		if (shifted) {
+			first += count;
+			last += count;
+		}
+
+		for (; first != last; ++first, ++where)
+			new(placeholder(), where) T(*first);
+	}
+
+	template<typename T>
+	template<typename... Args>
+	inline void vm_vector<T>::emplace(iterator where, Args&&... args) {
+		if (where == m_last) {
+			emplace_back(static_cast<Args&&>(args)...);
+			return;
+		}
+
+		// args may refer to elements that are about to shift
+		T value(static_cast<Args&&>(args)...);
+		where = insert_common(where, 1);
+		move_construct(where, value);
+	}
+
+	template<typename T>
+	inline typename vm_vector<T>::iterator vm_vector<T>::erase(iterator where) {
+		return erase(where, where + 1);
+	}
+
+	template<typename T>
+	inline typename vm_vector<T>::iterator vm_vector<T>::erase(iterator first, iterator last) {
+		buffer_erase_traits(first, last, m_last, relocatable_traits<T>());
+		m_last -= (last - first);
+		return first;
+	}
+
+	template<typename T>
+	inline typename vm_vector<T>::iterator vm_vector<T>::erase_unordered(iterator where) {
+		return erase_unordered(where, where + 1);
+	}
+
+	template<typename T>
+	inline typename vm_vector<T>::iterator vm_vector<T>::erase_unordered(iterator first, iterator last) {
+		buffer_erase_unordered_traits(first, last, m_last, relocatable_traits<T>());
+		m_last -= (last - first);
+		return first;
+	}
+}
+
+#endif
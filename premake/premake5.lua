@@ -41,6 +41,7 @@ project "test_tinystl"
 
 	files {
 		ROOT_DIR .. "test/**.cpp",
+		ROOT_DIR .. "test/**.h",
 		ROOT_DIR .. "include/**.h",
 	}
 
@@ -62,3 +63,31 @@ project "test_tinystl"
 			"_SCL_SECURE_NO_WARNINGS",
 			"_CRT_NONSTDC_NO_WARNINGS",
 		}
+
+	configuration { "linux" }
+		links {
+			"pthread",
+		}
+
+	configuration {}
+
+project "bench_tinystl"
+	kind "ConsoleApp"
+	optimize "Speed"
+
+	files {
+		ROOT_DIR .. "bench/**.cpp",
+		ROOT_DIR .. "bench/**.h",
+		ROOT_DIR .. "include/**.h",
+	}
+
+	includedirs {
+		ROOT_DIR .. "include/",
+	}
+
+	configuration { "linux" }
+		links {
+			"pthread",
+		}
+
+	configuration {}
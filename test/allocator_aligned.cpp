@@ -0,0 +1,93 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/arena_allocator.h>
+#include <TINYSTL/unordered_map.h>
+#include <TINYSTL/unordered_set.h>
+#include <TINYSTL/vector.h>
+#include <UnitTest++.h>
+
+struct alignas(64) cacheline {
+	cacheline() : value(0) {}
+	cacheline(int v) : value(v) {}
+
+	int value;
+};
+
+static inline bool operator==(const cacheline& lhs, const cacheline& rhs) {
+	return lhs.value == rhs.value;
+}
+
+static inline size_t hash(const cacheline& value) {
+	return tinystl::hash(value.value);
+}
+
+// Only provides the unaligned entry points, so containers align blocks themselves
+struct unaligned_allocator {
+	static void* static_allocate(size_t bytes) {
+		return operator new(bytes);
+	}
+
+	static void static_deallocate(void* ptr, size_t /*bytes*/) {
+		operator delete(ptr);
+	}
+};
+
+template<typename Alloc>
+static void check_vector_alignment(const Alloc& alloc) {
+	tinystl::vector<cacheline, Alloc> v(alloc);
+	for (int ii = 0; ii < 100; ++ii) {
+		v.push_back(cacheline(ii));
+		CHECK( ((size_t)v.data() & 63) == 0 );
+	}
+
+	v.resize(10);
+	v.shrink_to_fit();
+	CHECK( ((size_t)v.data() & 63) == 0 );
+	CHECK( v[9].value == 9 );
+}
+
+TEST(allocator_aligned_vector) {
+	check_vector_alignment(tinystl::allocator());
+	check_vector_alignment(unaligned_allocator());
+
+	tinystl::arena a;
+	check_vector_alignment(tinystl::arena_allocator(&a));
+}
+
+TEST(allocator_aligned_hash) {
+	tinystl::unordered_map<int, cacheline> m;
+	for (int ii = 0; ii < 100; ++ii) {
+		tinystl::unordered_map<int, cacheline>::iterator it = m.insert(tinystl::make_pair(ii, cacheline(ii))).first;
+		CHECK( ((size_t)&it->second & 63) == 0 );
+	}
+
+	tinystl::unordered_set<cacheline, unaligned_allocator> s;
+	for (int ii = 0; ii < 100; ++ii) {
+		tinystl::unordered_set<cacheline, unaligned_allocator>::iterator it = s.insert(cacheline(ii)).first;
+		CHECK( ((size_t)&*it & 63) == 0 );
+	}
+}
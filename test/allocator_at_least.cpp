@@ -0,0 +1,120 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/string.h>
+#include <TINYSTL/vector.h>
+#include <UnitTest++.h>
+#include <stdlib.h>
+
+// rounds every request up to a 64 byte class and checks deallocation sizes
+struct class_allocator {
+	static void* static_allocate(size_t bytes) {
+		++s_allocs;
+		return malloc(bytes);
+	}
+
+	static void* static_allocate_at_least(size_t bytes, size_t* actual) {
+		*actual = (bytes + 63) & ~(size_t)63;
+		return static_allocate(*actual);
+	}
+
+	static void static_deallocate(void* ptr, size_t bytes) {
+		if (ptr && (bytes == 0 || bytes > s_maxbytes))
+			++s_badfrees;
+		free(ptr);
+	}
+
+	static int s_allocs;
+	static int s_badfrees;
+	static size_t s_maxbytes;
+};
+
+int class_allocator::s_allocs;
+int class_allocator::s_badfrees;
+size_t class_allocator::s_maxbytes = 1024 * 1024;
+
+TEST(allocator_at_least_vector) {
+	class_allocator::s_allocs = 0;
+	class_allocator::s_badfrees = 0;
+	{
+		tinystl::vector<int, class_allocator> v;
+		v.reserve(1);
+		CHECK( v.capacity() == 16 );
+		CHECK( class_allocator::s_allocs == 1 );
+
+		for (int ii = 0; ii < 16; ++ii)
+			v.push_back(ii);
+		CHECK( class_allocator::s_allocs == 1 );
+
+		v.push_back(16);
+		CHECK( class_allocator::s_allocs == 2 );
+		CHECK( v.capacity() % 16 == 0 );
+		for (int ii = 0; ii < 17; ++ii)
+			CHECK( v[ii] == ii );
+
+		v.shrink_to_fit();
+		CHECK( v.capacity() == 17 );
+	}
+	CHECK( class_allocator::s_badfrees == 0 );
+}
+
+TEST(allocator_at_least_string) {
+	class_allocator::s_allocs = 0;
+	class_allocator::s_badfrees = 0;
+	{
+		const char* x = "x";
+		const char* y = "y";
+		tinystl::basic_string<class_allocator> s;
+		s.reserve(20);
+		CHECK( class_allocator::s_allocs == 1 );
+
+		// the whole 64 byte block is usable, terminator included
+		for (int ii = 0; ii < 63; ++ii)
+			s.append(x, x + 1);
+		CHECK( class_allocator::s_allocs == 1 );
+		CHECK( s.size() == 63 );
+		CHECK( s.c_str()[63] == 0 );
+
+		s.append(y, y + 1);
+		CHECK( class_allocator::s_allocs == 2 );
+		CHECK( s.size() == 64 );
+		CHECK( s.c_str()[63] == 'y' );
+	}
+	CHECK( class_allocator::s_badfrees == 0 );
+}
+
+TEST(allocator_at_least_default) {
+	tinystl::vector<char> v;
+	v.reserve(1);
+	CHECK( v.capacity() >= 1 );
+	CHECK( v.capacity() % tinystl::c_allocator_alignment == 0 );
+
+	tinystl::string s;
+	CHECK( s.c_str()[0] == 0 );
+	s.reserve(100);
+	CHECK( s.size() == 0 );
+	CHECK( s.c_str()[0] == 0 );
+}
@@ -0,0 +1,118 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/string.h>
+#include <TINYSTL/vector.h>
+#include <UnitTest++.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct realloc_allocator {
+	static void* static_allocate(size_t bytes) {
+		return malloc(bytes);
+	}
+
+	static void* static_reallocate(void* ptr, size_t /*oldbytes*/, size_t newbytes) {
+		++s_reallocs;
+		return realloc(ptr, newbytes);
+	}
+
+	static void static_deallocate(void* ptr, size_t /*bytes*/) {
+		free(ptr);
+	}
+
+	static int s_reallocs;
+};
+
+int realloc_allocator::s_reallocs;
+
+struct nonpod {
+	nonpod() : value(0) {}
+	nonpod(int v) : value(v) {}
+	nonpod(const nonpod& other) : value(other.value) {}
+	~nonpod() {}
+
+	int value;
+};
+
+TEST(allocator_reallocate_vector) {
+	realloc_allocator::s_reallocs = 0;
+
+	tinystl::vector<int, realloc_allocator> v;
+	for (int ii = 0; ii < 1000; ++ii)
+		v.push_back(ii);
+	CHECK( realloc_allocator::s_reallocs > 0 );
+	for (int ii = 0; ii < 1000; ++ii)
+		CHECK( v[ii] == ii );
+
+	const int reallocs = realloc_allocator::s_reallocs;
+	v.resize(10);
+	v.shrink_to_fit();
+	CHECK( realloc_allocator::s_reallocs == reallocs + 1 );
+	CHECK( v.capacity() == 10 );
+	CHECK( v[9] == 9 );
+}
+
+TEST(allocator_reallocate_nonpod) {
+	realloc_allocator::s_reallocs = 0;
+
+	tinystl::vector<nonpod, realloc_allocator> v;
+	for (int ii = 0; ii < 100; ++ii)
+		v.push_back(nonpod(ii));
+	CHECK( realloc_allocator::s_reallocs == 0 );
+	CHECK( v[99].value == 99 );
+}
+
+TEST(allocator_reallocate_string) {
+	realloc_allocator::s_reallocs = 0;
+
+	tinystl::basic_string<realloc_allocator> s("a string that does not fit inline");
+	const int reallocs = realloc_allocator::s_reallocs;
+
+	s.reserve(1000);
+	CHECK( realloc_allocator::s_reallocs == reallocs + 1 );
+	CHECK( 0 == strcmp(s.c_str(), "a string that does not fit inline") );
+
+	s.shrink_to_fit();
+	CHECK( realloc_allocator::s_reallocs == reallocs + 2 );
+	CHECK( 0 == strcmp(s.c_str(), "a string that does not fit inline") );
+}
+
+TEST(allocator_reallocate_large) {
+	// crosses the default allocator's mmap threshold
+	tinystl::vector<char> v;
+	v.resize(1024);
+	v[1023] = 'x';
+	v.reserve(48 * 1024 * 1024);
+	v.resize(48 * 1024 * 1024);
+	v[v.size() - 1] = 'y';
+	v.reserve(96 * 1024 * 1024);
+	CHECK( v[1023] == 'x' );
+	CHECK( v[v.size() - 1] == 'y' );
+	v.resize(2048);
+	v.shrink_to_fit();
+	CHECK( v[1023] == 'x' );
+}
@@ -0,0 +1,101 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/string.h>
+#include <TINYSTL/unordered_map.h>
+#include <TINYSTL/unordered_set.h>
+#include <TINYSTL/vector.h>
+#include <UnitTest++.h>
+
+#include "counting_allocator.h"
+
+TEST(allocator_stateful_empty_size) {
+	struct string_layout { char* first; char* last; char* capacity; char buffer[12]; };
+	struct hash_layout { size_t size; void* buckets[3]; void* nodes[4]; };
+
+	CHECK( sizeof(tinystl::vector<int>) == 3 * sizeof(int*) );
+	CHECK( sizeof(tinystl::string) == sizeof(string_layout) );
+	CHECK( sizeof(tinystl::unordered_set<int>) == sizeof(hash_layout) );
+	CHECK( sizeof(tinystl::unordered_map<int, int>) == sizeof(hash_layout) );
+}
+
+TEST(allocator_stateful_vector) {
+	int count = 0;
+	{
+		typedef tinystl::vector<int, counting_allocator> vector;
+		vector v((counting_allocator(&count)));
+		v.push_back(1);
+		v.push_back(2);
+		CHECK( count == 1 );
+
+		vector copy = v;
+		CHECK( count == 2 );
+		CHECK( copy.get_allocator().m_count == &count );
+
+		int other = 0;
+		vector w((counting_allocator(&other)));
+		w.push_back(3);
+		w.swap(v);
+		CHECK( w.get_allocator().m_count == &count );
+		CHECK( v.get_allocator().m_count == &other );
+		CHECK( count == 2 );
+		CHECK( other == 1 );
+	}
+	CHECK( count == 0 );
+}
+
+TEST(allocator_stateful_string) {
+	int count = 0;
+	{
+		typedef tinystl::basic_string<counting_allocator> string;
+		string s("a string long enough to leave the inline buffer", counting_allocator(&count));
+		CHECK( count == 1 );
+
+		string moved = static_cast<string&&>(s);
+		CHECK( count == 1 );
+		CHECK( moved.get_allocator().m_count == &count );
+
+		string small("small", counting_allocator(&count));
+		CHECK( count == 1 );
+	}
+	CHECK( count == 0 );
+}
+
+TEST(allocator_stateful_hash) {
+	int count = 0;
+	{
+		tinystl::unordered_map<int, int, counting_allocator> m((counting_allocator(&count)));
+		m.insert(tinystl::make_pair(1, 2));
+		m.insert(tinystl::make_pair(3, 4));
+		CHECK( count > 0 );
+
+		tinystl::unordered_set<int, counting_allocator> s((counting_allocator(&count)));
+		s.insert(1);
+		tinystl::unordered_set<int, counting_allocator> copy = s;
+		CHECK( copy.get_allocator().m_count == &count );
+	}
+	CHECK( count == 0 );
+}
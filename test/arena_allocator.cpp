@@ -0,0 +1,95 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/arena_allocator.h>
+#include <TINYSTL/string.h>
+#include <TINYSTL/unordered_map.h>
+#include <TINYSTL/vector.h>
+#include <UnitTest++.h>
+
+TEST(arena_allocate) {
+	tinystl::arena a(256);
+
+	char* p1 = (char*)a.allocate(10);
+	char* p2 = (char*)a.allocate(10);
+	CHECK( p1 != 0 );
+	CHECK( p2 >= p1 + 10 );
+	CHECK( ((size_t)p2 % (2 * sizeof(void*))) == 0 );
+
+	char* big = (char*)a.allocate(1024);
+	CHECK( big != 0 );
+	big[1023] = 1;
+}
+
+TEST(arena_mark_rewind) {
+	tinystl::arena a(256);
+	a.allocate(16);
+
+	const tinystl::arena::marker m = a.mark();
+	void* p1 = a.allocate(32);
+	for (int ii = 0; ii < 32; ++ii)
+		a.allocate(64);
+
+	a.rewind(m);
+	void* p2 = a.allocate(32);
+	CHECK( p1 == p2 );
+
+	a.reset();
+	void* p3 = a.allocate(16);
+	CHECK( p3 != 0 );
+}
+
+TEST(arena_containers) {
+	tinystl::arena a;
+	tinystl::arena_allocator alloc(&a);
+
+	tinystl::vector<int, tinystl::arena_allocator> v(alloc);
+	for (int ii = 0; ii < 1000; ++ii)
+		v.push_back(ii);
+	CHECK( v.size() == 1000 );
+	CHECK( v[999] == 999 );
+
+	tinystl::basic_string<tinystl::arena_allocator> s("a string that spills out of the inline buffer", alloc);
+	CHECK( s.size() == 45 );
+
+	tinystl::unordered_map<int, int, tinystl::arena_allocator> m(alloc);
+	for (int ii = 0; ii < 100; ++ii)
+		m.insert(tinystl::make_pair(ii, ii * 2));
+	CHECK( m.size() == 100 );
+	CHECK( m.find(42)->second == 84 );
+}
+
+TEST(arena_grow_in_place) {
+	tinystl::arena a;
+	tinystl::vector<int, tinystl::arena_allocator> v((tinystl::arena_allocator(&a)));
+	v.push_back(0);
+
+	const int* data = v.data();
+	for (int ii = 1; ii < 1000; ++ii)
+		v.push_back(ii);
+	CHECK( v.data() == data );
+	CHECK( v[999] == 999 );
+}
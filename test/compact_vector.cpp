@@ -0,0 +1,105 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/compact_vector.h>
+#include <TINYSTL/string.h>
+#include <TINYSTL/vector.h>
+#include <UnitTest++.h>
+#include <string.h>
+
+static bool equal(const tinystl::string& s, const char* expected) {
+	return 0 == strcmp(s.c_str(), expected);
+}
+
+TEST(compact_vector_footprint) {
+	CHECK_EQUAL(sizeof(void*) + 2 * sizeof(unsigned int), sizeof(tinystl::compact_vector<int>));
+	CHECK(sizeof(tinystl::compact_vector<int>) <= sizeof(tinystl::vector<int>));
+}
+
+TEST(compact_vector_primitive) {
+	tinystl::compact_vector<int> v;
+	CHECK(v.empty());
+	CHECK_EQUAL(0, v.capacity());
+
+	for (int ii = 0; ii < 100; ++ii)
+		v.push_back(ii);
+	CHECK_EQUAL(100, v.size());
+	CHECK(v.capacity() >= 100);
+
+	v.insert(v.begin(), -1);
+	v.emplace(v.begin() + 1, -2);
+	CHECK_EQUAL(-1, v[0]);
+	CHECK_EQUAL(-2, v[1]);
+	CHECK_EQUAL(0, v[2]);
+	CHECK_EQUAL(99, v.back());
+
+	v.erase(v.begin(), v.begin() + 2);
+	CHECK_EQUAL(0, v.front());
+	v.erase_unordered(v.begin());
+	CHECK_EQUAL(99, v.front());
+	CHECK_EQUAL(99, v.size());
+
+	// insert a range that lives inside the vector
+	v.insert(v.begin(), v.begin() + 1, v.begin() + 4);
+	CHECK_EQUAL(1, v[0]);
+	CHECK_EQUAL(3, v[2]);
+	CHECK_EQUAL(99, v[3]);
+
+	v.resize(10);
+	v.shrink_to_fit();
+	CHECK_EQUAL(10, v.capacity());
+
+	v.clear();
+	v.shrink_to_fit();
+	CHECK_EQUAL(0, v.capacity());
+	CHECK(v.data() == 0);
+}
+
+TEST(compact_vector_nonpod) {
+	typedef tinystl::compact_vector<tinystl::string> strings;
+
+	strings a;
+	a.push_back("alpha");
+	a.emplace_back("gamma");
+	a.insert(a.begin() + 1, tinystl::string("beta"));
+	a.push_back(a[0]);
+	CHECK_EQUAL(4, a.size());
+	CHECK(equal(a[1], "beta") && equal(a[3], "alpha"));
+
+	strings b(a);
+	strings c(static_cast<strings&&>(a));
+	CHECK(a.empty());
+	CHECK(equal(c[2], "gamma"));
+
+	b.swap(a);
+	CHECK_EQUAL(4, a.size());
+	CHECK(b.empty());
+
+	b = c;
+	b.erase(b.begin());
+	CHECK(equal(b[0], "beta"));
+	CHECK_EQUAL(4, c.size());
+}
@@ -0,0 +1,132 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/cuckoo_set.h>
+#include <TINYSTL/string.h>
+#include <TINYSTL/unordered_set.h>
+#include <UnitTest++.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "counting_allocator.h"
+
+TEST(cuckoo_set_bucket_layout) {
+	CHECK_EQUAL(32, sizeof(tinystl::cuckoo_set_bucket<uint32_t>));
+	CHECK_EQUAL(64, sizeof(tinystl::cuckoo_set_bucket<uint64_t>));
+	CHECK_EQUAL(64, alignof(tinystl::cuckoo_set_bucket<uint64_t>));
+}
+
+TEST(cuckoo_set_insert_find) {
+	typedef tinystl::cuckoo_set<uint64_t> set;
+	set s;
+	CHECK(s.empty());
+	CHECK(s.begin() == s.end());
+	CHECK(s.find(1) == s.end());
+
+	for (uint64_t ii = 0; ii < 20000; ++ii)
+		CHECK(s.insert(ii * 3).second);
+	CHECK(!s.insert(3).second);
+	CHECK_EQUAL(20000, s.size());
+	CHECK(s.capacity() - s.capacity() / 10 >= s.size());
+
+	for (uint64_t ii = 0; ii < 60000; ++ii)
+		CHECK_EQUAL(ii % 3 == 0, s.find(ii) != s.end());
+
+	size_t count = 0;
+	for (set::iterator it = s.begin(); it != s.end(); ++it) {
+		CHECK(*it % 3 == 0);
+		++count;
+	}
+	CHECK_EQUAL(20000, count);
+}
+
+TEST(cuckoo_set_high_load) {
+	// filling a reserved table to 0.9 must not grow it
+	typedef tinystl::cuckoo_set<uint32_t> set;
+	set s;
+	s.reserve(3600);
+	const size_t capacity = s.capacity();
+	CHECK_EQUAL(4096, capacity);
+	for (uint32_t ii = 0; ii < 3600; ++ii)
+		s.insert(ii * 2654435761u);
+	CHECK_EQUAL(capacity, s.capacity());
+	CHECK_EQUAL(3600, s.size());
+	for (uint32_t ii = 0; ii < 3600; ++ii)
+		CHECK(s.find(ii * 2654435761u) != s.end());
+}
+
+TEST(cuckoo_set_matches_unordered_set) {
+	tinystl::cuckoo_set<unsigned int> cuckoo;
+	tinystl::unordered_set<unsigned int> chained;
+
+	unsigned int state = 99;
+	for (int ii = 0; ii < 30000; ++ii) {
+		state = state * 1664525u + 1013904223u;
+		const unsigned int key = (state >> 8) % 4096;
+		if (state & 0x30) {
+			cuckoo.insert(key);
+			chained.insert(key);
+		} else {
+			CHECK_EQUAL(chained.erase(key), cuckoo.erase(key));
+		}
+	}
+
+	CHECK_EQUAL(chained.size(), cuckoo.size());
+	for (tinystl::unordered_set<unsigned int>::iterator it = chained.begin(); it != chained.end(); ++it)
+		CHECK(cuckoo.find(*it) != cuckoo.end());
+}
+
+TEST(cuckoo_set_nonpod) {
+	typedef tinystl::cuckoo_set<tinystl::string, counting_allocator> set;
+	int count = 0;
+	{
+		set s((counting_allocator(&count)));
+		char buffer[64];
+		for (int ii = 0; ii < 3000; ++ii) {
+			snprintf(buffer, sizeof(buffer), "a key long enough to leave the small buffer %d", ii);
+			s.emplace(tinystl::string(buffer));
+		}
+		for (int ii = 0; ii < 3000; ii += 2) {
+			snprintf(buffer, sizeof(buffer), "a key long enough to leave the small buffer %d", ii);
+			CHECK_EQUAL(1, s.erase(tinystl::string(buffer)));
+		}
+		CHECK_EQUAL(1500, s.size());
+
+		set copy = s;
+		s.clear();
+		CHECK(s.empty());
+		CHECK(copy.find(tinystl::string(buffer)) == copy.end());
+		snprintf(buffer, sizeof(buffer), "a key long enough to leave the small buffer %d", 2999);
+		CHECK(copy.find(tinystl::string(buffer)) != copy.end());
+
+		set moved = static_cast<set&&>(copy);
+		CHECK(copy.empty());
+		moved.swap(s);
+		CHECK_EQUAL(1500, s.size());
+		CHECK(s.find(tinystl::string(buffer)) != s.end());
+	}
+	CHECK_EQUAL(0, count);
+}
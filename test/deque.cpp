@@ -0,0 +1,147 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/deque.h>
+#include <TINYSTL/string.h>
+#include <UnitTest++.h>
+#include <string.h>
+
+#include "counting_allocator.h"
+
+TEST(deque_both_ends) {
+	tinystl::deque<int> d;
+	CHECK(d.empty());
+
+	for (int ii = 0; ii < 5000; ++ii) {
+		d.push_back(ii);
+		d.push_front(-ii - 1);
+	}
+	CHECK_EQUAL(10000, d.size());
+	CHECK_EQUAL(-5000, d.front());
+	CHECK_EQUAL(4999, d.back());
+	for (int ii = 0; ii < 10000; ++ii)
+		CHECK_EQUAL(ii - 5000, d[ii]);
+
+	for (int ii = 0; ii < 4000; ++ii) {
+		d.pop_front();
+		d.pop_back();
+	}
+	CHECK_EQUAL(2000, d.size());
+	CHECK_EQUAL(-1000, d.front());
+	CHECK_EQUAL(999, d.back());
+}
+
+TEST(deque_stable_addresses) {
+	tinystl::deque<int> d;
+	d.push_back(42);
+	const int* first = &d.front();
+
+	for (int ii = 0; ii < 100000; ++ii) {
+		d.push_back(ii);
+		d.push_front(ii);
+	}
+
+	CHECK(first == &d[100000]);
+	CHECK_EQUAL(42, *first);
+}
+
+TEST(deque_iterator) {
+	tinystl::deque<int> d;
+	for (int ii = 0; ii < 3000; ++ii)
+		d.push_back(ii);
+	d.push_front(-1);
+
+	int expected = -1;
+	for (tinystl::deque<int>::iterator it = d.begin(), end = d.end(); it != end; ++it, ++expected)
+		CHECK_EQUAL(expected, *it);
+
+	const tinystl::deque<int>& cd = d;
+	tinystl::deque<int>::const_iterator it = cd.begin();
+	CHECK_EQUAL(3001, cd.end() - it);
+	CHECK_EQUAL(1499, *(it + 1500));
+	CHECK_EQUAL(2999, it[3000]);
+	it += 2000;
+	CHECK_EQUAL(1999, *it);
+	it -= 1999;
+	CHECK_EQUAL(0, *it);
+	CHECK(it > cd.begin() && it < cd.end());
+
+	tinystl::deque<int>::const_iterator converted = d.begin();
+	CHECK(converted == cd.begin());
+}
+
+TEST(deque_nonpod) {
+	typedef tinystl::deque<tinystl::string> strings;
+
+	strings a;
+	a.push_back("middle");
+	a.emplace_front("first");
+	a.emplace_back("last");
+	a.push_back(a.front());
+
+	strings b(a);
+	CHECK_EQUAL(4, b.size());
+	CHECK(0 == strcmp(b[3].c_str(), "first"));
+
+	strings c(static_cast<strings&&>(a));
+	CHECK(a.empty());
+	CHECK(0 == strcmp(c[1].c_str(), "middle"));
+
+	a.swap(c);
+	CHECK_EQUAL(4, a.size());
+	CHECK(c.empty());
+
+	c = a;
+	c.resize(2);
+	CHECK(0 == strcmp(c.back().c_str(), "middle"));
+	c.resize(3, tinystl::string("new"));
+	CHECK(0 == strcmp(c.back().c_str(), "new"));
+}
+
+TEST(deque_releases_blocks) {
+	int count = 0;
+	{
+		tinystl::deque<int, counting_allocator> d((counting_allocator(&count)));
+		for (int ii = 0; ii < 100000; ++ii)
+			d.push_back(ii);
+
+		// draining from the front returns blocks as it goes
+		for (int ii = 0; ii < 100000; ++ii) {
+			d.push_back(ii);
+			d.pop_front();
+		}
+		for (int ii = 0; ii < 99990; ++ii)
+			d.pop_front();
+		CHECK(count <= 4);
+
+		d.clear();
+		d.shrink_to_fit();
+		CHECK_EQUAL(0, count);
+
+		d.push_front(1);
+	}
+	CHECK_EQUAL(0, count);
+}
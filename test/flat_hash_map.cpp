@@ -0,0 +1,204 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/flat_hash_map.h>
+#include <TINYSTL/string.h>
+#include <TINYSTL/unordered_map.h>
+#include <UnitTest++.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "counting_allocator.h"
+
+TEST(flat_hash_map_insert_find) {
+	typedef tinystl::flat_hash_map<int, int> map;
+	map m;
+	CHECK(m.empty());
+	CHECK(m.find(1) == m.end());
+	CHECK(m.begin() == m.end());
+
+	for (int ii = 0; ii < 1000; ++ii)
+		CHECK(m.insert(tinystl::make_pair(ii, ii * 2)).second);
+	CHECK_EQUAL(1000, m.size());
+	CHECK(!m.insert(tinystl::make_pair(7, 0)).second);
+	CHECK(m.capacity() - m.capacity() / 8 >= m.size());
+
+	for (int ii = 0; ii < 1000; ++ii) {
+		map::iterator it = m.find(ii);
+		CHECK(it != m.end());
+		CHECK_EQUAL(ii, it->first);
+		CHECK_EQUAL(ii * 2, it->second);
+	}
+	CHECK(m.find(1000) == m.end());
+	CHECK(m.find(-1) == m.end());
+
+	m[5] = 50;
+	CHECK_EQUAL(50, m.find(5)->second);
+	CHECK_EQUAL(0, m[2000]);
+	CHECK_EQUAL(1001, m.size());
+}
+
+TEST(flat_hash_map_iterate) {
+	typedef tinystl::flat_hash_map<int, int> map;
+	map m;
+	for (int ii = 0; ii < 300; ++ii)
+		m[ii] = ii;
+
+	int count = 0, sum = 0;
+	for (map::const_iterator it = m.begin(), end = m.end(); it != end; ++it) {
+		++count;
+		sum += it->second;
+	}
+	CHECK_EQUAL(300, count);
+	CHECK_EQUAL(300 * 299 / 2, sum);
+}
+
+TEST(flat_hash_map_erase) {
+	typedef tinystl::flat_hash_map<int, int> map;
+	map m;
+	for (int ii = 0; ii < 500; ++ii)
+		m[ii] = ii;
+
+	for (int ii = 0; ii < 500; ii += 2)
+		CHECK_EQUAL(1, m.erase(ii));
+	CHECK_EQUAL(0, m.erase(0));
+	m.erase(m.find(1));
+	CHECK_EQUAL(249, m.size());
+
+	for (int ii = 0; ii < 500; ++ii) {
+		if (ii % 2 == 0 || ii == 1)
+			CHECK(m.find(ii) == m.end());
+		else
+			CHECK_EQUAL(ii, m.find(ii)->second);
+	}
+
+	int count = 0;
+	for (map::iterator it = m.begin(); it != m.end(); ++it)
+		++count;
+	CHECK_EQUAL(249, count);
+}
+
+TEST(flat_hash_map_churn) {
+	// a sliding window of keys leaves tombstones behind; the table must
+	// reclaim them rather than grow without bound
+	typedef tinystl::flat_hash_map<unsigned int, unsigned int> map;
+	map m;
+	for (unsigned int ii = 0; ii < 100000; ++ii) {
+		m[ii] = ii;
+		if (ii >= 100)
+			CHECK_EQUAL(1, m.erase(ii - 100));
+	}
+	CHECK_EQUAL(100, m.size());
+	CHECK(m.capacity() <= 256);
+	for (unsigned int ii = 100000 - 100; ii < 100000; ++ii)
+		CHECK_EQUAL(ii, m.find(ii)->second);
+}
+
+TEST(flat_hash_map_matches_unordered_map) {
+	tinystl::flat_hash_map<unsigned int, unsigned int> flat;
+	tinystl::unordered_map<unsigned int, unsigned int> chained;
+
+	unsigned int state = 12345;
+	for (int ii = 0; ii < 20000; ++ii) {
+		state = state * 1664525u + 1013904223u;
+		const unsigned int key = (state >> 8) % 2048;
+		if (state & 0x10) {
+			flat[key] = state;
+			chained[key] = state;
+		} else {
+			flat.erase(key);
+			tinystl::unordered_map<unsigned int, unsigned int>::iterator it = chained.find(key);
+			if (it != chained.end())
+				chained.erase(it);
+		}
+	}
+
+	CHECK_EQUAL(chained.size(), flat.size());
+	for (tinystl::unordered_map<unsigned int, unsigned int>::iterator it = chained.begin(); it != chained.end(); ++it) {
+		tinystl::flat_hash_map<unsigned int, unsigned int>::iterator found = flat.find(it->first);
+		CHECK(found != flat.end());
+		CHECK_EQUAL(it->second, found->second);
+	}
+}
+
+TEST(flat_hash_map_string_keys) {
+	typedef tinystl::flat_hash_map<tinystl::string, tinystl::string> map;
+	map m;
+	char buffer[64];
+	for (int ii = 0; ii < 200; ++ii) {
+		snprintf(buffer, sizeof(buffer), "a key long enough to leave the small buffer %d", ii);
+		m.emplace(tinystl::make_pair(tinystl::string(buffer), tinystl::string(buffer + 2)));
+	}
+	CHECK_EQUAL(200, m.size());
+
+	snprintf(buffer, sizeof(buffer), "a key long enough to leave the small buffer %d", 123);
+	map::iterator it = m.find(tinystl::string(buffer));
+	CHECK(it != m.end());
+	CHECK(0 == strcmp(buffer + 2, it->second.c_str()));
+
+	map copy = m;
+	m.clear();
+	CHECK(m.empty());
+	CHECK(m.find(tinystl::string(buffer)) == m.end());
+	CHECK_EQUAL(200, copy.size());
+	CHECK(copy.find(tinystl::string(buffer)) != copy.end());
+
+	map moved = static_cast<map&&>(copy);
+	CHECK(copy.empty());
+	CHECK_EQUAL(200, moved.size());
+	CHECK(moved.find(tinystl::string(buffer)) != moved.end());
+}
+
+TEST(flat_hash_map_swap_reserve) {
+	typedef tinystl::flat_hash_map<int, int> map;
+	map a, b;
+	a.reserve(1000);
+	const size_t capacity = a.capacity();
+	CHECK(capacity - capacity / 8 >= 1000);
+	for (int ii = 0; ii < 1000; ++ii)
+		a[ii] = ii;
+	CHECK_EQUAL(capacity, a.capacity());
+
+	b[-1] = -1;
+	a.swap(b);
+	CHECK_EQUAL(1, a.size());
+	CHECK_EQUAL(1000, b.size());
+	CHECK_EQUAL(-1, a.find(-1)->second);
+	CHECK_EQUAL(999, b.find(999)->second);
+}
+
+TEST(flat_hash_map_allocator) {
+	int count = 0;
+	{
+		tinystl::flat_hash_map<int, tinystl::string, counting_allocator> m((counting_allocator(&count)));
+		for (int ii = 0; ii < 1000; ++ii)
+			m[ii] = "value that does not fit in the small string buffer";
+		for (int ii = 0; ii < 1000; ii += 3)
+			m.erase(ii);
+		CHECK(count > 0);
+	}
+	CHECK_EQUAL(0, count);
+}
@@ -0,0 +1,63 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/flat_hash_set.h>
+#include <UnitTest++.h>
+
+TEST(flat_hash_set_basic) {
+	typedef tinystl::flat_hash_set<unsigned int> set;
+	set s;
+	for (unsigned int ii = 0; ii < 1000; ++ii)
+		CHECK(s.insert(ii * 7).second);
+	CHECK(!s.insert(14).second);
+	CHECK_EQUAL(1000, s.size());
+
+	for (unsigned int ii = 0; ii < 7000; ++ii)
+		CHECK_EQUAL(ii % 7 == 0, s.find(ii) != s.end());
+
+	CHECK_EQUAL(1, s.erase(14));
+	CHECK_EQUAL(0, s.erase(14));
+	s.erase(s.find(21));
+	CHECK_EQUAL(998, s.size());
+
+	unsigned int count = 0;
+	for (set::iterator it = s.begin(); it != s.end(); ++it) {
+		CHECK(*it % 7 == 0);
+		++count;
+	}
+	CHECK_EQUAL(998, count);
+
+	set other = s;
+	s.clear();
+	CHECK(s.empty());
+	CHECK(s.begin() == s.end());
+	CHECK(other.find(7) != other.end());
+
+	s.emplace(5);
+	s.swap(other);
+	CHECK_EQUAL(1, other.size());
+	CHECK_EQUAL(998, s.size());
+}
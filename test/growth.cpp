@@ -0,0 +1,126 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/growth.h>
+#include <TINYSTL/string.h>
+#include <TINYSTL/vector.h>
+#include <UnitTest++.h>
+#include <stdlib.h>
+
+// exact-size allocator so capacities follow the policy alone
+struct exact_allocator {
+	static void* static_allocate(size_t bytes) {
+		++s_allocs;
+		return malloc(bytes);
+	}
+
+	static void static_deallocate(void* ptr, size_t /*bytes*/) {
+		free(ptr);
+	}
+
+	static int s_allocs;
+};
+
+int exact_allocator::s_allocs;
+
+TEST(growth_default) {
+	tinystl::vector<int, exact_allocator> v;
+	v.push_back(0);
+	CHECK( v.capacity() == 1 );
+	v.push_back(1);
+	CHECK( v.capacity() == 3 );
+	v.push_back(2);
+	v.push_back(3);
+	CHECK( v.capacity() == 6 );
+}
+
+TEST(growth_double) {
+	typedef tinystl::growth_allocator<tinystl::growth_factor<2, 1>, exact_allocator> alloc;
+
+	exact_allocator::s_allocs = 0;
+	tinystl::vector<int, alloc> v;
+	for (int ii = 0; ii < 1024; ++ii) {
+		v.push_back(ii);
+		CHECK( v.capacity() >= v.size() );
+	}
+	CHECK( v.capacity() == 1024 );
+	CHECK( exact_allocator::s_allocs == 11 );
+	for (int ii = 0; ii < 1024; ++ii)
+		CHECK( v[ii] == ii );
+}
+
+TEST(growth_tight) {
+	typedef tinystl::growth_allocator<tinystl::growth_factor<5, 4>, exact_allocator> alloc;
+
+	tinystl::vector<int, alloc> v(100, 0);
+	v.push_back(1);
+	CHECK( v.capacity() == 125 );
+
+	// the element being appended lives in the block that moves
+	v.resize(126);
+	v.push_back(v[100]);
+	CHECK( v.capacity() == 157 );
+	CHECK( v.back() == 1 );
+}
+
+TEST(growth_page_granular) {
+	typedef tinystl::growth_page_granular<4096, 16384> policy;
+	CHECK( policy::grow(0, 1000) == 1500 );
+	CHECK( policy::grow(16000, 16385) == 20480 );
+	CHECK( policy::grow(20480, 20481) == 28672 );
+	CHECK( policy::grow(4096000, 4096001) == 5120000 );
+}
+
+TEST(growth_page_granular_nonrelocatable) {
+	typedef tinystl::growth_allocator<tinystl::growth_page_granular<4096, 16384>, exact_allocator> alloc;
+
+	// strings are never moved with realloc, so every growth step copies
+	exact_allocator::s_allocs = 0;
+	tinystl::vector<tinystl::string, alloc> v;
+	const size_t count = 100000;
+	for (size_t ii = 0; ii < count; ++ii) {
+		const size_t capacity = v.capacity();
+		v.push_back(tinystl::string("x"));
+		if (v.capacity() != capacity && capacity * sizeof(tinystl::string) >= 16384)
+			CHECK( v.capacity() >= capacity + capacity / 4 );
+	}
+	CHECK( v.capacity() * sizeof(tinystl::string) > 16384 * 64 );
+	CHECK( exact_allocator::s_allocs < 64 );
+	CHECK( v.size() == count );
+	CHECK( v[count - 1] == tinystl::string("x") );
+}
+
+TEST(growth_string) {
+	typedef tinystl::growth_allocator<tinystl::growth_factor<2, 1>, exact_allocator> alloc;
+
+	exact_allocator::s_allocs = 0;
+	tinystl::basic_string<alloc> s;
+	const char* x = "x";
+	for (int ii = 0; ii < 1000; ++ii)
+		s.append(x, x + 1);
+	CHECK( s.size() == 1000 );
+	CHECK( exact_allocator::s_allocs == 7 );
+}
@@ -0,0 +1,92 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/hash.h>
+#include <TINYSTL/string.h>
+#include <UnitTest++.h>
+#include <string.h>
+
+static int hash_popcount(size_t value) {
+	int count = 0;
+	for (; value; value &= value - 1)
+		++count;
+	return count;
+}
+
+TEST(hash_string_content) {
+	// equal bytes hash equally wherever they sit in memory
+	char buffer[4096 + 16];
+	for (size_t ii = 0; ii < sizeof(buffer); ++ii)
+		buffer[ii] = (char)(ii * 31 + 7);
+
+	static const size_t lengths[] = { 0, 1, 3, 4, 7, 8, 15, 16, 17, 33, 48, 49, 96, 97, 1000, 4096 };
+	for (size_t ll = 0; ll < sizeof(lengths) / sizeof(lengths[0]); ++ll) {
+		const size_t len = lengths[ll];
+		char copy[4096 + 16];
+		memcpy(copy + 3, buffer, len);
+		CHECK_EQUAL(tinystl::hash_string(buffer, len), tinystl::hash_string(copy + 3, len));
+
+		// the length is part of the hash, so prefixes differ
+		if (len)
+			CHECK(tinystl::hash_string(buffer, len) != tinystl::hash_string(buffer, len - 1));
+	}
+
+	tinystl::string value("an example key that is longer than sixteen bytes");
+	CHECK_EQUAL(tinystl::hash_string(value.c_str(), value.size()), tinystl::hash(value));
+}
+
+TEST(hash_string_avalanche) {
+	// flipping any single input bit should flip about half the output bits
+	char key[64];
+	for (size_t ii = 0; ii < sizeof(key); ++ii)
+		key[ii] = (char)ii;
+
+	static const size_t lengths[] = { 3, 8, 12, 16, 40, 64 };
+	for (size_t ll = 0; ll < sizeof(lengths) / sizeof(lengths[0]); ++ll) {
+		const size_t len = lengths[ll];
+		const size_t base = tinystl::hash_string(key, len);
+
+		int flipped = 0, trials = 0;
+		for (size_t bit = 0; bit < len * 8; ++bit) {
+			key[bit / 8] ^= (char)(1 << (bit % 8));
+			flipped += hash_popcount(base ^ tinystl::hash_string(key, len));
+			key[bit / 8] ^= (char)(1 << (bit % 8));
+			++trials;
+		}
+
+		const double average = (double)flipped / trials / (sizeof(size_t) * 8);
+		CHECK(average > 0.4 && average < 0.6);
+	}
+}
+
+TEST(hash_integers) {
+	// neighbouring integers must differ in their low bits, which open
+	// addressing tables use to pick a slot
+	int collisions = 0;
+	for (size_t ii = 0; ii < 1024; ++ii)
+		collisions += ((tinystl::hash(ii) & 127) == (tinystl::hash(ii + 1) & 127));
+	CHECK(collisions < 32);
+}
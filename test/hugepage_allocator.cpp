@@ -0,0 +1,92 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/hugepage_allocator.h>
+#include <TINYSTL/vector.h>
+#include <UnitTest++.h>
+
+TEST(hugepage_vector) {
+	typedef tinystl::vector<size_t, tinystl::hugepage_allocator> vector;
+
+	vector v;
+	v.reserve(TINYSTL_HUGEPAGE_SIZE);
+#if TINYSTL_ALLOCATOR_MREMAP
+	CHECK( ((size_t)v.data() & (TINYSTL_HUGEPAGE_SIZE - 1)) == 0 );
+#endif
+
+	for (size_t ii = 0; ii < 2 * TINYSTL_HUGEPAGE_SIZE; ++ii)
+		v.push_back(ii);
+	for (size_t ii = 0; ii < v.size(); ++ii) {
+		if (v[ii] != ii) {
+			CHECK( v[ii] == ii );
+			break;
+		}
+	}
+
+	v.resize(TINYSTL_HUGEPAGE_SIZE / 4);
+	v.shrink_to_fit();
+	CHECK( v.capacity() == TINYSTL_HUGEPAGE_SIZE / 4 );
+	CHECK( v.back() == TINYSTL_HUGEPAGE_SIZE / 4 - 1 );
+
+	v.resize(16);
+	v.shrink_to_fit();
+	CHECK( v.capacity() == 16 );
+	CHECK( v.back() == 15 );
+}
+
+TEST(hugepage_reallocate_aligned) {
+#if TINYSTL_ALLOCATOR_MREMAP
+	// map a page right after the block before each growth step so growing
+	// in place fails and the block has to move
+	typedef tinystl::hugepage_allocator alloc;
+	const size_t page = TINYSTL_HUGEPAGE_SIZE;
+	const size_t blocker = 4096;
+
+	void* blockers[8] = {};
+	size_t size = page;
+	char* ptr = (char*)alloc::static_allocate(size);
+	ptr[0] = 42;
+	for (int ii = 0; ii < 8; ++ii) {
+		blockers[ii] = mmap(ptr + size, blocker, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+		char* grown = (char*)alloc::static_reallocate(ptr, size, size + page);
+		CHECK( grown != 0 );
+		if (!grown)
+			break;
+		ptr = grown;
+		size += page;
+		CHECK( ((size_t)ptr & (page - 1)) == 0 );
+		CHECK( ptr[0] == 42 );
+		ptr[size - 1] = 1;
+	}
+
+	alloc::static_deallocate(ptr, size);
+	for (int ii = 0; ii < 8; ++ii) {
+		if (blockers[ii] && blockers[ii] != MAP_FAILED)
+			munmap(blockers[ii], blocker);
+	}
+#endif
+}
@@ -0,0 +1,141 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/mpmc_queue.h>
+#include <TINYSTL/string.h>
+#include <TINYSTL/vector.h>
+#include <UnitTest++.h>
+#include <string.h>
+#include <thread>
+
+TEST(mpmc_queue_bounded) {
+	tinystl::mpmc_queue<int> q(5);
+	CHECK_EQUAL(8, q.capacity());
+	CHECK(q.empty());
+
+	int out = -1;
+	CHECK(!q.pop(out));
+	CHECK_EQUAL(-1, out);
+
+	for (int ii = 0; ii < 8; ++ii)
+		CHECK(q.push(ii));
+	CHECK(!q.push(8));
+	CHECK_EQUAL(8, q.size());
+
+	// each slot is reused on many laps
+	for (int ii = 0; ii < 1000; ++ii) {
+		CHECK(q.pop(out));
+		CHECK_EQUAL(ii, out);
+		CHECK(q.push(ii + 8));
+	}
+
+	while (q.pop())
+		;
+	CHECK(q.empty());
+	CHECK(q.push(0));
+}
+
+TEST(mpmc_queue_nonpod) {
+	tinystl::mpmc_queue<tinystl::string> q(4);
+	CHECK(q.emplace("first"));
+	CHECK(q.push(tinystl::string("second")));
+	const tinystl::string third("third");
+	CHECK(q.push(third));
+
+	tinystl::string out;
+	CHECK(q.pop(out));
+	CHECK(0 == strcmp(out.c_str(), "first"));
+	CHECK(q.pop(out));
+	CHECK(0 == strcmp(out.c_str(), "second"));
+	CHECK_EQUAL(1, q.size());
+}
+
+static const size_t c_mpmc_threads = 4;
+static const size_t c_mpmc_items = 50000;
+
+// Producer p pushes p * c_mpmc_items up to (p + 1) * c_mpmc_items
+static void mpmc_produce(tinystl::mpmc_queue<size_t>* q, size_t producer) {
+	for (size_t ii = 0; ii < c_mpmc_items; ) {
+		if (q->push(producer * c_mpmc_items + ii))
+			++ii;
+		else
+			std::this_thread::yield();
+	}
+}
+
+static void mpmc_consume(tinystl::mpmc_queue<size_t>* q, size_t* remaining, tinystl::vector<size_t>* popped) {
+	size_t value;
+	while (tinystl::atomic_load_relaxed(remaining)) {
+		if (q->pop(value)) {
+			popped->push_back(value);
+			tinystl::atomic_fetch_add(remaining, (size_t)-1);
+		} else {
+			std::this_thread::yield();
+		}
+	}
+}
+
+TEST(mpmc_queue_threaded) {
+	tinystl::mpmc_queue<size_t> q(64);
+	size_t remaining = c_mpmc_threads * c_mpmc_items;
+
+	tinystl::vector<size_t> popped[c_mpmc_threads];
+	std::thread threads[2 * c_mpmc_threads];
+	for (size_t ii = 0; ii < c_mpmc_threads; ++ii) {
+		threads[ii] = std::thread(mpmc_consume, &q, &remaining, &popped[ii]);
+		threads[c_mpmc_threads + ii] = std::thread(mpmc_produce, &q, ii);
+	}
+	for (size_t ii = 0; ii < 2 * c_mpmc_threads; ++ii)
+		threads[ii].join();
+	CHECK(q.empty());
+
+	// every value is popped exactly once, and each consumer sees any one
+	// producer's values in the order they were pushed
+	tinystl::vector<unsigned char> seen(c_mpmc_threads * c_mpmc_items, 0);
+	bool duplicate = false, ordered = true;
+	for (size_t cc = 0; cc < c_mpmc_threads; ++cc) {
+		size_t last[c_mpmc_threads];
+		for (size_t pp = 0; pp < c_mpmc_threads; ++pp)
+			last[pp] = (size_t)-1;
+
+		for (size_t ii = 0; ii < popped[cc].size(); ++ii) {
+			const size_t value = popped[cc][ii];
+			duplicate |= (seen[value] != 0);
+			seen[value] = 1;
+
+			const size_t producer = value / c_mpmc_items;
+			ordered &= (last[producer] == (size_t)-1 || last[producer] < value);
+			last[producer] = value;
+		}
+	}
+
+	size_t total = 0;
+	for (size_t ii = 0; ii < seen.size(); ++ii)
+		total += seen[ii];
+	CHECK(!duplicate);
+	CHECK(ordered);
+	CHECK_EQUAL(c_mpmc_threads * c_mpmc_items, total);
+}
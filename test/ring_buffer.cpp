@@ -0,0 +1,122 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/ring_buffer.h>
+#include <TINYSTL/string.h>
+#include <UnitTest++.h>
+#include <string.h>
+
+TEST(ring_buffer_fifo) {
+	tinystl::ring_buffer<int> r;
+	CHECK(r.empty());
+
+	int next = 0, expected = 0;
+	for (int round = 0; round < 1000; ++round) {
+		for (int ii = 0; ii < 3; ++ii)
+			r.push_back(next++);
+		for (int ii = 0; ii < 2; ++ii, ++expected) {
+			CHECK_EQUAL(expected, r.front());
+			r.pop_front();
+		}
+	}
+
+	CHECK_EQUAL(1000, r.size());
+	CHECK_EQUAL(0, r.capacity() & (r.capacity() - 1));
+	for (size_t ii = 0; ii < r.size(); ++ii)
+		CHECK_EQUAL(expected + (int)ii, r[ii]);
+	CHECK_EQUAL(next - 1, r.back());
+}
+
+TEST(ring_buffer_spans) {
+	tinystl::ring_buffer<int> r;
+	r.reserve(8);
+	CHECK_EQUAL(8, r.capacity());
+
+	for (int ii = 0; ii < 6; ++ii)
+		r.push_back(ii);
+	r.pop_front(4);
+	const int more[] = { 6, 7, 8, 9 };
+	r.push_back(more, more + 4);
+
+	// 4 5 6 7 at the end of the block, 8 9 wrapped to the front
+	tinystl::ring_span<int> first = r.first_span(), second = r.second_span();
+	CHECK_EQUAL(4, first.size());
+	CHECK_EQUAL(2, second.size());
+	CHECK_EQUAL(4, first.first[0]);
+	CHECK_EQUAL(9, second.first[1]);
+
+	int out[8];
+	CHECK_EQUAL(5, r.pop_front(out, out + 5));
+	CHECK_EQUAL(8, out[4]);
+	CHECK_EQUAL(1, r.size());
+	CHECK_EQUAL(9, r.front());
+	CHECK_EQUAL(1, r.pop_front(out, out + 8));
+	CHECK(r.empty());
+}
+
+TEST(ring_buffer_grow_keeps_order) {
+	tinystl::ring_buffer<int> r;
+	r.reserve(8);
+	for (int ii = 0; ii < 8; ++ii)
+		r.push_back(ii);
+	r.pop_front(5);
+	for (int ii = 8; ii < 13; ++ii)
+		r.push_back(ii);
+
+	// full and wrapped, the next push grows the block
+	CHECK_EQUAL(8, r.size());
+	r.push_back(r.front());
+	CHECK_EQUAL(16, r.capacity());
+	for (int ii = 0; ii < 8; ++ii)
+		CHECK_EQUAL(5 + ii, r[ii]);
+	CHECK_EQUAL(5, r.back());
+}
+
+TEST(ring_buffer_nonpod) {
+	typedef tinystl::ring_buffer<tinystl::string> strings;
+
+	strings r;
+	for (int ii = 0; ii < 20; ++ii) {
+		char text[2] = { (char)('a' + ii), 0 };
+		r.emplace_back(text);
+		if (ii & 1)
+			r.pop_front();
+	}
+	CHECK_EQUAL(10, r.size());
+	CHECK(0 == strcmp(r.front().c_str(), "k"));
+
+	strings copy(r);
+	strings moved(static_cast<strings&&>(r));
+	CHECK(r.empty());
+	CHECK(0 == strcmp(copy.back().c_str(), "t"));
+	CHECK(0 == strcmp(moved[1].c_str(), "l"));
+
+	r = copy;
+	r.pop_front(9);
+	CHECK(0 == strcmp(r.front().c_str(), "t"));
+	r.clear();
+	CHECK(r.empty());
+}
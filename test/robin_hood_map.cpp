@@ -0,0 +1,147 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/robin_hood_map.h>
+#include <TINYSTL/string.h>
+#include <TINYSTL/unordered_map.h>
+#include <UnitTest++.h>
+#include <stdint.h>
+
+#include "counting_allocator.h"
+
+TEST(robin_hood_map_insert_find) {
+	typedef tinystl::robin_hood_map<uint64_t, uint64_t> map;
+	map m;
+	CHECK(m.empty());
+	CHECK(m.begin() == m.end());
+	CHECK(m.find(3) == m.end());
+
+	for (uint64_t ii = 0; ii < 5000; ++ii)
+		CHECK(m.insert(tinystl::make_pair(ii * 977, ii)).second);
+	CHECK(!m.insert(tinystl::make_pair((uint64_t)977, (uint64_t)0)).second);
+	CHECK_EQUAL(5000, m.size());
+
+	for (uint64_t ii = 0; ii < 5000; ++ii) {
+		map::iterator it = m.find(ii * 977);
+		CHECK(it != m.end());
+		CHECK_EQUAL(ii, it->second);
+		CHECK(m.find(ii * 977 + 1) == m.end());
+	}
+
+	m[977] = 42;
+	CHECK_EQUAL(42u, m.find(977)->second);
+	CHECK_EQUAL(0u, m[1]);
+	CHECK_EQUAL(5001, m.size());
+
+	size_t count = 0;
+	for (map::const_iterator it = m.begin(); it != m.end(); ++it)
+		++count;
+	CHECK_EQUAL(5001, count);
+}
+
+TEST(robin_hood_map_load_factor) {
+	typedef tinystl::robin_hood_map<uint64_t, uint64_t> map;
+	map m;
+	m.reserve(900);
+	const size_t capacity = m.capacity();
+	CHECK_EQUAL(1024, capacity);
+	for (uint64_t ii = 0; ii < 900; ++ii)
+		m[ii] = ii;
+	CHECK_EQUAL(capacity, m.capacity());
+	for (uint64_t ii = 0; ii < 900; ++ii)
+		CHECK_EQUAL(ii, m.find(ii)->second);
+}
+
+TEST(robin_hood_map_backward_shift) {
+	// erasing must close every gap so later lookups in the same run still
+	// succeed and the table never fills with dead slots
+	typedef tinystl::robin_hood_map<unsigned int, unsigned int> map;
+	map m;
+	for (unsigned int ii = 0; ii < 200000; ++ii) {
+		m[ii] = ii;
+		if (ii >= 1000)
+			CHECK_EQUAL(1, m.erase(ii - 1000));
+	}
+	CHECK_EQUAL(1000, m.size());
+	CHECK(m.capacity() <= 2048);
+	for (unsigned int ii = 0; ii < 200000; ++ii)
+		CHECK_EQUAL(ii >= 199000, m.find(ii) != m.end());
+}
+
+TEST(robin_hood_map_matches_unordered_map) {
+	tinystl::robin_hood_map<unsigned int, unsigned int> rh;
+	tinystl::unordered_map<unsigned int, unsigned int> chained;
+
+	unsigned int state = 777;
+	for (int ii = 0; ii < 30000; ++ii) {
+		state = state * 1664525u + 1013904223u;
+		const unsigned int key = (state >> 8) % 4096;
+		if (state & 0x30) {
+			rh[key] = state;
+			chained[key] = state;
+		} else {
+			const tinystl::robin_hood_map<unsigned int, unsigned int>::iterator found = rh.find(key);
+			if (found != rh.end())
+				rh.erase(found);
+			tinystl::unordered_map<unsigned int, unsigned int>::iterator it = chained.find(key);
+			if (it != chained.end())
+				chained.erase(it);
+		}
+	}
+
+	CHECK_EQUAL(chained.size(), rh.size());
+	for (tinystl::unordered_map<unsigned int, unsigned int>::iterator it = chained.begin(); it != chained.end(); ++it) {
+		tinystl::robin_hood_map<unsigned int, unsigned int>::iterator found = rh.find(it->first);
+		CHECK(found != rh.end());
+		CHECK_EQUAL(it->second, found->second);
+	}
+}
+
+TEST(robin_hood_map_nonpod) {
+	typedef tinystl::robin_hood_map<int, tinystl::string, counting_allocator> map;
+	int count = 0;
+	{
+		map m((counting_allocator(&count)));
+		for (int ii = 0; ii < 2000; ++ii)
+			m[ii] = "a value too long for the small string buffer";
+		for (int ii = 0; ii < 2000; ii += 2)
+			m.erase(ii);
+		CHECK_EQUAL(1000, m.size());
+
+		map copy = m;
+		m.clear();
+		CHECK(m.empty());
+		CHECK(copy.find(1) != copy.end());
+		CHECK(copy.find(2) == copy.end());
+
+		map moved = static_cast<map&&>(copy);
+		CHECK(copy.empty());
+		moved.swap(m);
+		CHECK_EQUAL(1000, m.size());
+		CHECK_EQUAL(tinystl::string("a value too long for the small string buffer").size(), m.find(999)->second.size());
+	}
+	CHECK_EQUAL(0, count);
+}
@@ -0,0 +1,163 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/arena_allocator.h>
+#include <TINYSTL/small_vector.h>
+#include <TINYSTL/string.h>
+#include <UnitTest++.h>
+
+#include "counting_allocator.h"
+
+template<typename Vector>
+static bool small_is_inline(const Vector& v) {
+	const char* data = (const char*)v.data();
+	const char* self = (const char*)&v;
+	return data >= self && data < self + sizeof(v);
+}
+
+TEST(small_vector_inline) {
+	typedef tinystl::small_vector_allocator<int, 8, counting_allocator> allocator;
+
+	int count = 0;
+	{
+		tinystl::small_vector<int, 8, counting_allocator> v((allocator(counting_allocator(&count))));
+		for (int ii = 0; ii < 8; ++ii)
+			v.push_back(ii);
+		CHECK( v.capacity() == 8 );
+		CHECK( small_is_inline(v) );
+		CHECK( count == 0 );
+
+		v.push_back(8);
+		CHECK( !small_is_inline(v) );
+		CHECK( count == 1 );
+		for (int ii = 0; ii < 9; ++ii)
+			CHECK( v[ii] == ii );
+
+		v.resize(4);
+		v.shrink_to_fit();
+		CHECK( small_is_inline(v) );
+		CHECK( count == 0 );
+		for (int ii = 0; ii < 4; ++ii)
+			CHECK( v[ii] == ii );
+	}
+	CHECK( count == 0 );
+}
+
+TEST(small_vector_copy_move) {
+	typedef tinystl::small_vector<tinystl::string, 4> vector;
+
+	vector a;
+	a.push_back(tinystl::string("one"));
+	a.push_back(tinystl::string("a string long enough for the heap"));
+
+	vector b(a);
+	CHECK( small_is_inline(b) );
+	CHECK( b.size() == 2 && b[1] == a[1] );
+
+	vector c(static_cast<vector&&>(a));
+	CHECK( small_is_inline(c) );
+	CHECK( c.size() == 2 );
+	CHECK( c[0] == tinystl::string("one") );
+	CHECK( a.empty() );
+
+	vector big;
+	for (int ii = 0; ii < 10; ++ii)
+		big.push_back(tinystl::string("element"));
+	const tinystl::string* data = big.data();
+	vector stolen(static_cast<vector&&>(big));
+	CHECK( stolen.data() == data );
+	CHECK( stolen.size() == 10 );
+
+	c = static_cast<vector&&>(stolen);
+	CHECK( c.size() == 10 );
+	b = c;
+	CHECK( b.size() == 10 );
+	c = vector();
+	CHECK( c.empty() );
+}
+
+TEST(small_vector_swap) {
+	typedef tinystl::small_vector<int, 4> vector;
+
+	vector small1, small2, big;
+	small1.push_back(1);
+	small2.push_back(2);
+	small2.push_back(3);
+	for (int ii = 0; ii < 10; ++ii)
+		big.push_back(ii);
+
+	small1.swap(small2);
+	CHECK( small1.size() == 2 && small1[1] == 3 );
+	CHECK( small2.size() == 1 && small2[0] == 1 );
+	CHECK( small_is_inline(small1) && small_is_inline(small2) );
+
+	small1.swap(big);
+	CHECK( small1.size() == 10 && small1[9] == 9 );
+	CHECK( big.size() == 2 && big[0] == 2 && big[1] == 3 );
+	CHECK( !small_is_inline(small1) && small_is_inline(big) );
+
+	vector big2;
+	for (int ii = 0; ii < 6; ++ii)
+		big2.push_back(-ii);
+	const int* data1 = small1.data();
+	const int* data2 = big2.data();
+	small1.swap(big2);
+	CHECK( small1.data() == data2 && big2.data() == data1 );
+}
+
+struct alignas(32) small_aligned {
+	float values[8];
+};
+
+TEST(small_vector_aligned) {
+	tinystl::small_vector<small_aligned, 2> v;
+	v.resize(2);
+	CHECK( small_is_inline(v) );
+	CHECK( ((size_t)v.data() & 31) == 0 );
+	v.resize(5);
+	CHECK( !small_is_inline(v) );
+	CHECK( ((size_t)v.data() & 31) == 0 );
+}
+
+TEST(small_vector_nested_relocation) {
+	// an allocator that opts in to relocation must not make the inline
+	// storage relocatable along with it
+	typedef tinystl::small_vector_allocator<int, 4, tinystl::arena_allocator> inner_allocator;
+	typedef tinystl::small_vector<int, 4, tinystl::arena_allocator> inner;
+	CHECK( !tinystl::is_trivially_relocatable<inner>::value );
+
+	tinystl::arena a;
+	tinystl::vector<inner> outer;
+	for (int ii = 0; ii < 64; ++ii) {
+		outer.push_back(inner(inner_allocator(tinystl::arena_allocator(&a))));
+		outer.back().push_back(ii);
+	}
+
+	for (int ii = 0; ii < 64; ++ii) {
+		CHECK( small_is_inline(outer[ii]) );
+		CHECK( outer[ii][0] == ii );
+	}
+}
@@ -0,0 +1,170 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/spsc_queue.h>
+#include <TINYSTL/string.h>
+#include <UnitTest++.h>
+#include <string.h>
+#include <thread>
+
+TEST(spsc_queue_layout) {
+	typedef tinystl::spsc_queue<int> queue;
+	CHECK_EQUAL((size_t)TINYSTL_CACHE_LINE_SIZE, alignof(queue));
+	CHECK_EQUAL((size_t)3 * TINYSTL_CACHE_LINE_SIZE, sizeof(queue));
+
+	queue q(100);
+	CHECK_EQUAL(128, q.capacity());
+}
+
+TEST(spsc_queue_bounded) {
+	tinystl::spsc_queue<int> q(4);
+	CHECK(q.empty());
+
+	int out = -1;
+	CHECK(!q.pop(out));
+	CHECK_EQUAL(-1, out);
+
+	for (int ii = 0; ii < 4; ++ii)
+		CHECK(q.push(ii));
+	CHECK(!q.push(4));
+	CHECK_EQUAL(4, q.size());
+
+	// indices wrap around the block many times
+	for (int ii = 0; ii < 1000; ++ii) {
+		CHECK(q.pop(out));
+		CHECK_EQUAL(ii, out);
+		CHECK(q.push(ii + 4));
+	}
+	CHECK_EQUAL(4, q.size());
+}
+
+TEST(spsc_queue_batch) {
+	tinystl::spsc_queue<int> q(8);
+
+	int in[12];
+	for (int ii = 0; ii < 12; ++ii)
+		in[ii] = ii;
+
+	CHECK_EQUAL(8, q.push(in, in + 12));
+	CHECK_EQUAL(0, q.push(in, in + 1));
+
+	int out[12];
+	CHECK_EQUAL(5, q.pop(out, out + 5));
+	CHECK_EQUAL(4, out[4]);
+	CHECK_EQUAL(4, q.push(in + 8, in + 12));
+	CHECK_EQUAL(7, q.pop(out, out + 12));
+	for (int ii = 0; ii < 7; ++ii)
+		CHECK_EQUAL(5 + ii, out[ii]);
+	CHECK(q.empty());
+}
+
+TEST(spsc_queue_nonpod) {
+	{
+		tinystl::spsc_queue<tinystl::string> q(4);
+		CHECK(q.emplace("first"));
+		CHECK(q.push(tinystl::string("second")));
+		const tinystl::string third("third");
+		CHECK(q.push(third));
+
+		tinystl::string out;
+		CHECK(q.pop(out));
+		CHECK(0 == strcmp(out.c_str(), "first"));
+		CHECK(q.pop());
+		CHECK_EQUAL(1, q.size());
+	}
+}
+
+static const size_t c_spsc_items = 200000;
+
+static void spsc_produce(tinystl::spsc_queue<size_t>* q) {
+	for (size_t ii = 0; ii < c_spsc_items; ) {
+		if (q->push(ii))
+			++ii;
+		else
+			std::this_thread::yield();
+	}
+}
+
+// pushes runs of 1 to 37 items at a time
+static void spsc_produce_batch(tinystl::spsc_queue<size_t>* q) {
+	size_t in[37];
+	for (size_t next = 0, run = 1; next < c_spsc_items; run = run % 37 + 1) {
+		size_t count = (run < c_spsc_items - next) ? run : c_spsc_items - next;
+		for (size_t ii = 0; ii < count; ++ii)
+			in[ii] = next + ii;
+
+		for (size_t pushed = 0; pushed != count; ) {
+			const size_t n = q->push(in + pushed, in + count);
+			if (!n)
+				std::this_thread::yield();
+			pushed += n;
+		}
+		next += count;
+	}
+}
+
+TEST(spsc_queue_threaded) {
+	// every value arrives exactly once and in order, across many wraps of
+	// a small queue
+	tinystl::spsc_queue<size_t> q(64);
+	std::thread producer(spsc_produce, &q);
+
+	size_t expected = 0;
+	bool ordered = true;
+	while (expected < c_spsc_items) {
+		size_t value;
+		if (q.pop(value)) {
+			ordered &= (value == expected);
+			++expected;
+		} else {
+			std::this_thread::yield();
+		}
+	}
+	producer.join();
+
+	CHECK(ordered);
+	CHECK(q.empty());
+}
+
+TEST(spsc_queue_threaded_batch) {
+	tinystl::spsc_queue<size_t> q(64);
+	std::thread producer(spsc_produce_batch, &q);
+
+	size_t out[50];
+	size_t expected = 0;
+	bool ordered = true;
+	while (expected < c_spsc_items) {
+		const size_t count = q.pop(out, out + 1 + expected % 50);
+		if (!count)
+			std::this_thread::yield();
+		for (size_t ii = 0; ii < count; ++ii)
+			ordered &= (out[ii] == expected++);
+	}
+	producer.join();
+
+	CHECK(ordered);
+	CHECK(q.empty());
+}
@@ -0,0 +1,120 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/static_vector.h>
+#include <TINYSTL/string.h>
+#include <UnitTest++.h>
+#include <string.h>
+
+static bool equal(const tinystl::string& s, const char* expected) {
+	return 0 == strcmp(s.c_str(), expected);
+}
+
+TEST(static_vector_size_type) {
+	CHECK_EQUAL(sizeof(unsigned char), sizeof(tinystl::static_vector_size<255>::type));
+	CHECK_EQUAL(sizeof(unsigned short), sizeof(tinystl::static_vector_size<256>::type));
+	CHECK_EQUAL(sizeof(unsigned short), sizeof(tinystl::static_vector_size<65535>::type));
+	CHECK_EQUAL(sizeof(unsigned int), sizeof(tinystl::static_vector_size<65536>::type));
+	CHECK_EQUAL((size_t)201, sizeof(tinystl::static_vector<char, 200>));
+}
+
+TEST(static_vector_overflow) {
+	tinystl::static_vector<int, 4> v;
+	CHECK(v.push_back(1));
+	CHECK(v.push_back(2));
+	CHECK(v.emplace_back(3));
+	CHECK(v.insert(v.begin(), 0));
+	CHECK(v.full());
+
+	CHECK(!v.push_back(5));
+	CHECK(!v.emplace_back(5));
+	CHECK(!v.insert(v.begin(), 5));
+	CHECK(!v.emplace(v.begin(), 5));
+	CHECK(!v.resize(5));
+
+	CHECK_EQUAL(4, v.size());
+	for (int ii = 0; ii != 4; ++ii)
+		CHECK_EQUAL(ii, v[ii]);
+
+	v.pop_back();
+	CHECK(v.resize(4, 7));
+	CHECK_EQUAL(7, v.back());
+}
+
+TEST(static_vector_insert_erase) {
+	typedef tinystl::static_vector<tinystl::string, 8> strings;
+
+	strings v;
+	v.push_back("a");
+	v.push_back("d");
+	const tinystl::string mid[] = { "b", "c" };
+	CHECK(v.insert(v.begin() + 1, mid, mid + 2));
+	CHECK(v.emplace(v.end(), "e"));
+	CHECK_EQUAL(5, v.size());
+	CHECK(equal(v[0], "a") && equal(v[1], "b") && equal(v[2], "c") && equal(v[3], "d") && equal(v[4], "e"));
+
+	// insert from within the vector
+	CHECK(v.insert(v.begin(), v.begin() + 3, v.begin() + 5));
+	CHECK(equal(v[0], "d") && equal(v[1], "e") && equal(v[2], "a") && equal(v[6], "e"));
+
+	CHECK(!v.insert(v.begin(), mid, mid + 2));
+	CHECK_EQUAL(7, v.size());
+
+	strings::iterator it = v.erase(v.begin(), v.begin() + 2);
+	CHECK(it == v.begin());
+	CHECK_EQUAL(5, v.size());
+	CHECK(equal(v[0], "a") && equal(v[4], "e"));
+
+	v.erase_unordered(v.begin());
+	CHECK_EQUAL(4, v.size());
+	CHECK(equal(v[0], "e") && equal(v[1], "b") && equal(v[3], "d"));
+}
+
+TEST(static_vector_copy_move) {
+	typedef tinystl::static_vector<tinystl::string, 4> strings;
+
+	strings a;
+	a.push_back("one");
+	a.push_back("two");
+
+	strings b(a);
+	CHECK_EQUAL(2, b.size());
+	CHECK(equal(b[1], "two"));
+
+	strings c(static_cast<strings&&>(a));
+	CHECK(a.empty());
+	CHECK(equal(c[0], "one"));
+
+	a.push_back("three");
+	a.swap(c);
+	CHECK_EQUAL(2, a.size());
+	CHECK_EQUAL(1, c.size());
+	CHECK(equal(a[0], "one") && equal(c[0], "three"));
+
+	b = c;
+	CHECK_EQUAL(1, b.size());
+	CHECK(equal(b[0], "three"));
+}
@@ -85,3 +85,26 @@ TEST(string_assign) {
 		CHECK( other.size() == 0 );
 	}
 }
+
+TEST(string_shrinktofit) {
+	using tinystl::string;
+
+	{
+		string s("a string that does not fit inline");
+		s.clear();
+		s.shrink_to_fit();
+		CHECK( s.size() == 0 );
+		CHECK( 0 == strcmp(s.c_str(), "") );
+
+		const char* text = "again";
+		s.append(text, text + 5);
+		CHECK( 0 == strcmp(s.c_str(), "again") );
+	}
+	{
+		string s("a string that does not fit inline");
+		s.resize(4);
+		s.shrink_to_fit();
+		CHECK( s.size() == 4 );
+		CHECK( 0 == strcmp(s.c_str(), "a st") );
+	}
+}
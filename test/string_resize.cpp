@@ -36,3 +36,18 @@ TEST(string_resize_propery) {
 	CHECK(s.size() == 3);
 	CHECK(0 == strcmp(s.c_str(), "new"));
 }
+
+TEST(string_resize_uninitialized) {
+	tinystl::string s("hello");
+	s.resize_uninitialized(100);
+	CHECK(s.size() == 100);
+	CHECK(s.c_str()[100] == 0);
+	CHECK(0 == strncmp(s.c_str(), "hello", 5));
+
+	memset(s.data() + 5, 'x', 95);
+	CHECK(s.c_str()[99] == 'x');
+
+	s.resize_uninitialized(3);
+	CHECK(s.size() == 3);
+	CHECK(0 == strcmp(s.c_str(), "hel"));
+}
@@ -0,0 +1,90 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/thread_cache_allocator.h>
+#include <TINYSTL/string.h>
+#include <TINYSTL/unordered_map.h>
+#include <TINYSTL/vector.h>
+#include <UnitTest++.h>
+
+TEST(thread_cache_size_class) {
+	using tinystl::thread_cache_size_class;
+	using tinystl::thread_cache_class_size;
+
+	for (size_t bytes = 1; bytes <= tinystl::c_thread_cache_max_size; ++bytes) {
+		const size_t sizeclass = thread_cache_size_class(bytes);
+		CHECK( sizeclass < tinystl::c_thread_cache_nclasses );
+		CHECK( thread_cache_class_size(sizeclass) >= bytes );
+		if (sizeclass)
+			CHECK( thread_cache_class_size(sizeclass - 1) < bytes );
+	}
+
+	CHECK( thread_cache_size_class(tinystl::c_thread_cache_max_size) == tinystl::c_thread_cache_nclasses - 1 );
+}
+
+TEST(thread_cache_reuse) {
+	typedef tinystl::thread_cache_allocator alloc;
+
+	void* p1 = alloc::static_allocate(100);
+	alloc::static_deallocate(p1, 100);
+	void* p2 = alloc::static_allocate(110);
+	CHECK( p1 == p2 );
+	alloc::static_deallocate(p2, 110);
+
+	void* blocks[200];
+	for (int ii = 0; ii < 200; ++ii)
+		blocks[ii] = alloc::static_allocate(48);
+	for (int ii = 0; ii < 200; ++ii)
+		alloc::static_deallocate(blocks[ii], 48);
+	for (int ii = 0; ii < 200; ++ii)
+		blocks[ii] = alloc::static_allocate(48);
+	for (int ii = 0; ii < 200; ++ii)
+		alloc::static_deallocate(blocks[ii], 48);
+
+	void* large = alloc::static_allocate(1024 * 1024);
+	alloc::static_deallocate(large, 1024 * 1024);
+	alloc::static_deallocate(0, 0);
+}
+
+TEST(thread_cache_containers) {
+	typedef tinystl::thread_cache_allocator alloc;
+
+	tinystl::vector<int, alloc> v;
+	for (int ii = 0; ii < 10000; ++ii)
+		v.push_back(ii);
+	CHECK( v[9999] == 9999 );
+	v.shrink_to_fit();
+
+	tinystl::basic_string<alloc> s("a string that does not fit inline");
+	s.resize(100);
+	s.shrink_to_fit();
+	CHECK( s.size() == 100 );
+
+	tinystl::unordered_map<int, int, alloc> m;
+	for (int ii = 0; ii < 1000; ++ii)
+		m.insert(tinystl::make_pair(ii, ii));
+	CHECK( m.find(500)->second == 500 );
+}
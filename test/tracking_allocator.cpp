@@ -0,0 +1,111 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/tracking_allocator.h>
+#include <TINYSTL/string.h>
+#include <TINYSTL/unordered_map.h>
+#include <TINYSTL/vector.h>
+#include <UnitTest++.h>
+#include <string.h>
+
+struct tracking_named_tag {
+	static const char* name() { return "named"; }
+};
+
+struct tracking_plain_tag {};
+
+namespace tracking_test {
+	template<typename T> struct widget {};
+}
+
+TEST(tracking_vector_counts) {
+	typedef tinystl::tracking_allocator<tracking_named_tag> alloc;
+	{
+		tinystl::vector<int, alloc> v;
+		for (int ii = 0; ii < 100; ++ii)
+			v.push_back(ii);
+
+		const tinystl::tracking_counts counts = tinystl::tracking_tag_counts<tracking_named_tag>();
+		CHECK( strcmp(counts.name, "named") == 0 );
+		CHECK( counts.allocations + counts.reallocations > 1 );
+		CHECK( counts.live_bytes == v.capacity() * sizeof(int) );
+		CHECK( counts.peak_bytes >= counts.live_bytes );
+	}
+
+	const tinystl::tracking_counts counts = tinystl::tracking_tag_counts<tracking_named_tag>();
+	CHECK( counts.live_bytes == 0 );
+	CHECK( counts.allocations == counts.frees );
+	CHECK( counts.peak_bytes >= 100 * sizeof(int) );
+}
+
+TEST(tracking_type_names) {
+	tinystl::tracking_allocator<tracking_plain_tag>::static_deallocate(
+		tinystl::tracking_allocator<tracking_plain_tag>::static_allocate(16), 16);
+	CHECK( strstr(tinystl::tracking_tag_counts<tracking_plain_tag>().name, "tracking_plain_tag") != 0 );
+
+	typedef tracking_test::widget<int> widget_tag;
+	const char* name = tinystl::tracking_tag_counts<widget_tag>().name;
+	CHECK( strstr(name, "widget<int>") != 0 );
+	CHECK( strchr(name, ']') == 0 );
+}
+
+TEST(tracking_registry) {
+	typedef tinystl::unordered_map<int, int> map_tag;
+	{
+		tinystl::unordered_map<int, int, tinystl::tracking_allocator<map_tag> > m;
+		for (int ii = 0; ii < 50; ++ii)
+			m.insert(tinystl::make_pair(ii, ii));
+
+		tinystl::basic_string<tinystl::tracking_allocator<map_tag> > s("a string that does not fit inline");
+		CHECK( tinystl::tracking_tag_counts<map_tag>().live_bytes > 0 );
+	}
+
+	bool found = false;
+	for (const tinystl::tracking_stats* it = tinystl::tracking_first_stats(); it; it = it->next) {
+		if (strstr(it->name, "unordered_map<int, int")) {
+			const tinystl::tracking_counts counts = tinystl::tracking_read_counts(it);
+			CHECK( counts.allocations > 0 );
+			CHECK( counts.live_bytes == 0 );
+			found = true;
+		}
+	}
+	CHECK( found );
+}
+
+struct alignas(64) tracking_aligned {
+	char data[64];
+};
+
+TEST(tracking_aligned) {
+	typedef tinystl::tracking_allocator<tracking_aligned> alloc;
+	{
+		tinystl::vector<tracking_aligned, alloc> v;
+		v.resize(10);
+		CHECK( ((size_t)v.data() & 63) == 0 );
+		CHECK( tinystl::tracking_tag_counts<tracking_aligned>().live_bytes == 10 * sizeof(tracking_aligned) );
+	}
+	CHECK( tinystl::tracking_tag_counts<tracking_aligned>().live_bytes == 0 );
+}
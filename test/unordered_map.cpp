@@ -184,3 +184,32 @@ TEST(uomap_insert) {
 		CHECK( p.second.size() == 0 );
 	}
 }
+
+TEST(uomap_erase_reuses_node) {
+	typedef tinystl::unordered_map<int, int> unordered_map;
+	using tinystl::make_pair;
+
+	unordered_map m;
+	for (int ii = 0; ii < 100; ++ii)
+		m.insert(make_pair(ii, ii));
+
+	const unordered_map::iterator erased = m.find(50);
+	const void* node = &*erased;
+	m.erase(erased);
+	CHECK( m.size() == 99 );
+	CHECK( m.find(50) == m.end() );
+
+	unordered_map::iterator it = m.insert(make_pair(1000, 1)).first;
+	CHECK( &*it == node );
+	CHECK( m.find(1000)->second == 1 );
+
+	for (int ii = 0; ii < 100; ++ii) {
+		if (ii != 50)
+			CHECK( m.find(ii)->second == ii );
+	}
+
+	m.clear();
+	CHECK( m.empty() );
+	m.insert(make_pair(1, 1));
+	CHECK( m.find(1)->second == 1 );
+}
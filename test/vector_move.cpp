@@ -0,0 +1,134 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/string.h>
+#include <TINYSTL/vector.h>
+#include <UnitTest++.h>
+
+static int s_copies;
+static int s_moves;
+
+struct heavy {
+	heavy() : a(0), b(0) {}
+	heavy(int a_, int b_) : a(a_), b(b_) {}
+	heavy(const heavy& other) : a(other.a), b(other.b) { ++s_copies; }
+	heavy(heavy&& other) : a(other.a), b(other.b) { other.a = other.b = -1; ++s_moves; }
+	~heavy() {}
+
+	heavy& operator=(const heavy& other) { a = other.a; b = other.b; ++s_copies; return *this; }
+	heavy& operator=(heavy&& other) { a = other.a; b = other.b; other.a = other.b = -1; ++s_moves; return *this; }
+
+	int a, b;
+};
+
+struct moveonly {
+	moveonly() : value(0) {}
+	explicit moveonly(int v) : value(new int(v)) {}
+	moveonly(moveonly&& other) : value(other.value) { other.value = 0; }
+	~moveonly() { delete value; }
+
+	moveonly& operator=(moveonly&& other) {
+		delete value;
+		value = other.value;
+		other.value = 0;
+		return *this;
+	}
+
+	int* value;
+
+private:
+	moveonly(const moveonly&);
+	moveonly& operator=(const moveonly&);
+};
+
+TEST(vector_move_no_copies) {
+	s_copies = 0;
+	s_moves = 0;
+
+	tinystl::vector<heavy> v;
+	for (int ii = 0; ii < 100; ++ii)
+		v.emplace_back(ii, ii * 2);
+	for (int ii = 100; ii < 200; ++ii)
+		v.push_back(heavy(ii, ii * 2));
+	v.emplace(v.begin(), -5, -10);
+	v.insert(v.begin() + 1, heavy(-3, -6));
+	v.erase(v.begin(), v.begin() + 2);
+
+	CHECK( s_copies == 0 );
+	CHECK( s_moves > 0 );
+	CHECK( v.size() == 200 );
+	for (int ii = 0; ii < 200; ++ii) {
+		CHECK( v[ii].a == ii );
+		CHECK( v[ii].b == ii * 2 );
+	}
+}
+
+TEST(vector_move_aliasing) {
+	tinystl::vector<heavy> v;
+	v.emplace_back(1, 2);
+	v.shrink_to_fit();
+
+	// the argument lives in the buffer that is about to grow
+	v.emplace_back(v[0]);
+	v.push_back(v[1]);
+	v.emplace(v.begin(), v.back());
+	CHECK( v.size() == 4 );
+	for (size_t ii = 0; ii < v.size(); ++ii)
+		CHECK( v[ii].a == 1 && v[ii].b == 2 );
+
+	v.shrink_to_fit();
+	v.push_back(static_cast<heavy&&>(v[3]));
+	CHECK( v[4].a == 1 );
+	CHECK( v[3].a == -1 );
+}
+
+TEST(vector_move_only) {
+	tinystl::vector<moveonly> v;
+	for (int ii = 0; ii < 20; ++ii)
+		v.emplace_back(ii);
+	v.push_back(moveonly(20));
+	v.insert(v.begin(), moveonly(-1));
+	v.erase(v.begin());
+	v.erase(v.begin() + 5);
+
+	CHECK( v.size() == 20 );
+	for (int ii = 0; ii < 20; ++ii)
+		CHECK( *v[ii].value == ((ii < 5) ? ii : ii + 1) );
+}
+
+TEST(vector_move_strings) {
+	tinystl::vector<tinystl::string> v;
+	v.emplace_back("short");
+	v.emplace_back("a string that is too long for the inline buffer");
+	v.emplace_back("sized", (size_t)3);
+	for (int ii = 0; ii < 50; ++ii)
+		v.emplace(v.begin(), "filler string that lives on the heap");
+
+	CHECK( v.size() == 53 );
+	CHECK( v[50] == tinystl::string("short") );
+	CHECK( v[51] == tinystl::string("a string that is too long for the inline buffer") );
+	CHECK( v[52] == tinystl::string("siz") );
+}
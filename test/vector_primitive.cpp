@@ -251,3 +251,17 @@ TEST(vector_iterator) {
 	CHECK(v.begin() != w.begin());
 	CHECK(v.end() != w.end());
 }
+
+TEST(vector_resize_uninitialized) {
+	tinystl::vector<int> v(4, 7);
+	v.resize_uninitialized(1000);
+	CHECK(v.size() == 1000);
+	CHECK(v[3] == 7);
+	for (size_t ii = 0; ii < v.size(); ++ii)
+		v[ii] = (int)ii;
+	CHECK(v[999] == 999);
+
+	v.resize_uninitialized(10);
+	CHECK(v.size() == 10);
+	CHECK(v[9] == 9);
+}
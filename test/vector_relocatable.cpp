@@ -0,0 +1,131 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/arena_allocator.h>
+#include <TINYSTL/string.h>
+#include <TINYSTL/unordered_map.h>
+#include <TINYSTL/vector.h>
+#include <UnitTest++.h>
+
+static int s_copies;
+static int s_destroyed;
+
+struct relocatable {
+	typedef relocatable tinystl_relocatable;
+
+	relocatable() : value(0) {}
+	relocatable(int v) : value(v) {}
+	relocatable(const relocatable& other) : value(other.value) { ++s_copies; }
+	relocatable(relocatable&& other) : value(other.value) {}
+	~relocatable() { ++s_destroyed; }
+
+	relocatable& operator=(const relocatable& other) { value = other.value; ++s_copies; return *this; }
+
+	int value;
+	char padding[60];
+};
+
+struct not_relocatable {
+	not_relocatable() {}
+	not_relocatable(const not_relocatable&) {}
+};
+
+// inherits the opt-in typedef, but points into itself
+struct derived_from_relocatable : relocatable {
+	derived_from_relocatable() : self(this) {}
+	derived_from_relocatable(const derived_from_relocatable&) : relocatable(), self(this) {}
+
+	derived_from_relocatable* self;
+};
+
+TEST(relocatable_trait) {
+	using tinystl::is_trivially_relocatable;
+	CHECK( is_trivially_relocatable<int>::value );
+	CHECK( is_trivially_relocatable<relocatable>::value );
+	CHECK( !is_trivially_relocatable<not_relocatable>::value );
+	CHECK( !is_trivially_relocatable<derived_from_relocatable>::value );
+	CHECK( !is_trivially_relocatable<tinystl::string>::value );
+	CHECK( is_trivially_relocatable<tinystl::vector<not_relocatable> >::value );
+	CHECK( (is_trivially_relocatable<tinystl::vector<int, tinystl::arena_allocator> >::value) );
+	CHECK( (is_trivially_relocatable<tinystl::unordered_map<int, tinystl::string> >::value) );
+	CHECK( (is_trivially_relocatable<tinystl::pair<int, tinystl::vector<int> > >::value) );
+	CHECK( (!is_trivially_relocatable<tinystl::pair<int, tinystl::string> >::value) );
+}
+
+TEST(relocatable_vector_bitwise) {
+	s_copies = 0;
+	s_destroyed = 0;
+	{
+		tinystl::vector<relocatable> v;
+		for (int ii = 0; ii < 100; ++ii)
+			v.push_back(relocatable(ii));
+		// growth relocates instead of copying
+		CHECK( s_copies == 0 );
+
+		const relocatable first(-1);
+		v.insert(v.begin(), first);
+		CHECK( s_copies == 1 );
+		CHECK( v[0].value == -1 );
+		CHECK( v[100].value == 99 );
+
+		s_destroyed = 0;
+		v.erase(v.begin(), v.begin() + 11);
+		CHECK( s_copies == 1 );
+		CHECK( s_destroyed == 11 );
+		CHECK( v.size() == 90 );
+		for (int ii = 0; ii < 90; ++ii)
+			CHECK( v[ii].value == ii + 10 );
+
+		v.erase_unordered(v.begin(), v.begin() + 5);
+		CHECK( s_destroyed == 16 );
+		CHECK( v.size() == 85 );
+		CHECK( v[0].value == 95 );
+		CHECK( v[4].value == 99 );
+		CHECK( v[5].value == 15 );
+
+		s_destroyed = 0;
+	}
+	// the 85 elements and first
+	CHECK( s_destroyed == 86 );
+}
+
+TEST(relocatable_nested_vectors) {
+	tinystl::vector<tinystl::vector<int> > v;
+	for (int ii = 0; ii < 50; ++ii) {
+		tinystl::vector<int> inner;
+		for (int jj = 0; jj <= ii; ++jj)
+			inner.push_back(jj);
+		v.insert(v.begin(), inner);
+	}
+
+	v.erase(v.begin() + 10, v.begin() + 20);
+	CHECK( v.size() == 40 );
+	for (size_t ii = 0; ii < v.size(); ++ii) {
+		const size_t expected = (ii < 10) ? 50 - ii : 40 - ii;
+		CHECK( v[ii].size() == expected );
+		CHECK( v[ii].back() == (int)expected - 1 );
+	}
+}
@@ -0,0 +1,105 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/string.h>
+#include <TINYSTL/vm_vector.h>
+#include <UnitTest++.h>
+#include <string.h>
+
+TEST(vm_vector_stable_data) {
+	tinystl::vm_vector<int> v;
+	CHECK(v.data() == 0);
+
+	v.push_back(0);
+	const int* first = v.data();
+	for (int ii = 1; ii < 1000000; ++ii)
+		v.push_back(ii);
+
+	CHECK(first == v.data());
+	CHECK_EQUAL(1000000, v.size());
+	CHECK(v.capacity() >= v.size());
+	for (int ii = 0; ii < 1000000; ii += 997)
+		CHECK_EQUAL(ii, v[ii]);
+}
+
+TEST(vm_vector_shrink) {
+	tinystl::vm_vector<char> v;
+	v.resize(1 << 20, 'x');
+	const char* first = v.data();
+
+	v.resize(10);
+	v.shrink_to_fit();
+	CHECK(v.capacity() < (1 << 20));
+	CHECK(v.capacity() >= 10);
+	CHECK_EQUAL('x', v[9]);
+
+	// decommitted pages come back zeroed and usable
+	v.resize(1 << 20, 'y');
+	CHECK(first == v.data());
+	CHECK_EQUAL('x', v[9]);
+	CHECK_EQUAL('y', v[(1 << 20) - 1]);
+}
+
+TEST(vm_vector_reservation) {
+	tinystl::vm_vector<int> v(tinystl::vm_reservation(1 << 16));
+	CHECK_EQUAL((size_t)(1 << 14), v.max_size());
+	v.resize(v.max_size(), 7);
+	CHECK_EQUAL(v.max_size(), v.capacity());
+	CHECK_EQUAL(7, v.back());
+}
+
+TEST(vm_vector_insert_erase) {
+	typedef tinystl::vm_vector<tinystl::string> strings;
+
+	strings v;
+	v.push_back("b");
+	v.insert(v.begin(), tinystl::string("a"));
+	v.emplace(v.end(), "d");
+	v.emplace(v.begin() + 2, "c");
+	CHECK_EQUAL(4, v.size());
+	CHECK(0 == strcmp(v[2].c_str(), "c"));
+
+	v.insert(v.begin(), v.begin() + 2, v.end());
+	CHECK_EQUAL(6, v.size());
+	CHECK(0 == strcmp(v[0].c_str(), "c"));
+	CHECK(0 == strcmp(v[2].c_str(), "a"));
+
+	v.erase(v.begin(), v.begin() + 2);
+	CHECK(0 == strcmp(v[0].c_str(), "a"));
+	v.erase_unordered(v.begin());
+	CHECK(0 == strcmp(v[0].c_str(), "d"));
+
+	strings copy(v);
+	strings moved(static_cast<strings&&>(v));
+	CHECK(v.empty());
+	CHECK_EQUAL(3, copy.size());
+	CHECK_EQUAL(3, moved.size());
+	CHECK(copy.data() != moved.data());
+
+	copy.swap(v);
+	CHECK_EQUAL(3, v.size());
+	CHECK(copy.empty());
+}